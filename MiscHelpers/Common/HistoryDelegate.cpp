@@ -0,0 +1,147 @@
+#include "stdafx.h"
+#include "HistoryDelegate.h"
+
+CHistoryDelegate::CHistoryDelegate(QAbstractItemDelegate* pBaseDelegate, QObject* parent) : QStyledItemDelegate(parent)
+{
+	m_pBaseDelegate = pBaseDelegate;
+	m_Tick = 0;
+}
+
+void CHistoryDelegate::AddColumn(int Column, const QList<QColor>& Colors, QColor BkG)
+{
+	SColumn& Info = m_Columns[Column];
+	Info.Colors.clear();
+	foreach(const QColor& Color, Colors)
+		Info.Colors.append(Color.rgb());
+	Info.BkG = BkG.rgb();
+	Info.History.clear();
+}
+
+void CHistoryDelegate::BeginUpdate()
+{
+	m_Tick++;
+}
+
+void CHistoryDelegate::AddSample(int Column, quint64 Id, quint64 Tag, const float* pValues, int Capacity)
+{
+	QMap<int, SColumn>::iterator I = m_Columns.find(Column);
+	if (I == m_Columns.end())
+		return;
+	int Values = I->Colors.size();
+
+	SHistory& History = I->History[Id];
+	if (History.Tag != Tag || History.Last + 1 != m_Tick)
+		History.Count = 0; // a new row or a gap in the samples
+	History.Tag = Tag;
+
+	// Note: the capacity follows the column width, a hidden column has a width of 0, then we keep what we have
+	if (Capacity > 0 && Capacity != History.Capacity)
+		Resize(History, Values, Capacity);
+	if (History.Capacity == 0)
+		return;
+
+	quint8* pSample = History.Samples.data() + (m_Tick % History.Capacity) * Values;
+	for (int i = 0; i < Values; i++)
+		pSample[i] = (quint8)(qBound(0.0f, pValues[i], 1.0f) * 255.0f + 0.5f);
+
+	History.Last = m_Tick;
+	if (History.Count < History.Capacity)
+		History.Count++;
+}
+
+void CHistoryDelegate::EndUpdate()
+{
+	// drop the rows which did not get a sample, they are gone
+	for (QMap<int, SColumn>::iterator I = m_Columns.begin(); I != m_Columns.end(); ++I)
+	{
+		for (QHash<quint64, SHistory>::iterator J = I->History.begin(); J != I->History.end();)
+		{
+			if (J->Last != m_Tick)
+				J = I->History.erase(J);
+			else
+				++J;
+		}
+	}
+}
+
+void CHistoryDelegate::Resize(SHistory& History, int Values, int Capacity)
+{
+	QVector<quint8> Samples(Capacity * Values, 0);
+	int Count = qMin(History.Count, Capacity);
+	for (int i = 0; i < Count; i++)
+	{
+		quint64 Tick = History.Last - i;
+		memcpy(Samples.data() + (Tick % Capacity) * Values, History.Samples.constData() + (Tick % History.Capacity) * Values, Values);
+	}
+	History.Samples = Samples;
+	History.Capacity = Capacity;
+	History.Count = Count;
+}
+
+void CHistoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+	// let the base delegate paint the selection and grid
+	if (m_pBaseDelegate)
+		m_pBaseDelegate->paint(painter, option, index);
+	else
+		QStyledItemDelegate::paint(painter, option, index);
+
+	QMap<int, SColumn>::const_iterator I = m_Columns.find(index.column());
+	if (I == m_Columns.end())
+		return;
+
+	// Note: we leave the right and bottom line of the cell for the grid
+	QRect Rect = option.rect.adjusted(0, 0, -1, -1);
+	int Width = Rect.width();
+	int Height = Rect.height();
+	if (Width <= 0 || Height <= 0)
+		return;
+
+	quint64 Id = index.sibling(index.row(), 0).data(Qt::UserRole).toULongLong();
+	QHash<quint64, SHistory>::const_iterator J = I->History.find(Id);
+	const SHistory* pHistory = J != I->History.end() ? &J.value() : NULL;
+	int Count = pHistory ? qMin(pHistory->Count, Width) : 0;
+
+	// the cells are rendered into one reused image, each pixel column is one sample
+	if (m_Scratch.width() < Width || m_Scratch.height() < Height)
+		m_Scratch = QImage(qMax(Width, m_Scratch.width()), qMax(Height, m_Scratch.height()), QImage::Format_RGB32);
+	ASSERT(m_Scratch.depth() == 32);
+
+	int Values = I->Colors.size();
+	const QRgb* pColors = I->Colors.constData();
+	int Stride = m_Scratch.bytesPerLine() / sizeof(QRgb);
+	QRgb* pBottom = (QRgb*)m_Scratch.bits() + (Height - 1) * Stride;
+	for (int x = 0; x < Width; x++)
+	{
+		QRgb* pPixel = pBottom + x;
+		int Top = 0;
+
+		int Age = Width - 1 - x;
+		if (Age < Count)
+		{
+			const quint8* pSample = pHistory->Samples.constData() + ((pHistory->Last - Age) % pHistory->Capacity) * Values;
+
+			// later values are painted over the earlier ones, same as CHistoryGraph in simple mode
+			for (int i = 0; i < Values; i++)
+			{
+				int y = (pSample[i] * Height + 127) / 255;
+				for (int k = 0; k < y; k++)
+					pPixel[-k * Stride] = pColors[i];
+				if (y > Top)
+					Top = y;
+			}
+		}
+
+		for (int k = Top; k < Height; k++)
+			pPixel[-k * Stride] = I->BkG;
+	}
+
+	painter->drawImage(Rect.topLeft(), m_Scratch, QRect(0, 0, Width, Height));
+}
+
+QSize CHistoryDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+	if (m_pBaseDelegate)
+		return m_pBaseDelegate->sizeHint(option, index);
+	return QStyledItemDelegate::sizeHint(option, index);
+}
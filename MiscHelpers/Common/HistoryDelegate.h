@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../mischelpers_global.h"
+
+// Paints the history graphs of many rows directly from compact per row sample rings, no widgets or images per row are needed.
+// All rows share one time base, once per update BeginUpdate, AddSample for each row and EndUpdate are called,
+// the newest sample is painted at the right edge of the cell, one sample per pixel.
+class MISCHELPERS_EXPORT CHistoryDelegate : public QStyledItemDelegate
+{
+public:
+	CHistoryDelegate(QAbstractItemDelegate* pBaseDelegate = NULL, QObject* parent = NULL);
+	~CHistoryDelegate() {}
+
+	void		AddColumn(int Column, const QList<QColor>& Colors, QColor BkG = Qt::white);
+
+	void		BeginUpdate();
+	// Id is the value of Qt::UserRole of the first column, Tag tells a reused id apart, e.g. the creation time of a process
+	void		AddSample(int Column, quint64 Id, quint64 Tag, const float* pValues, int Capacity);
+	void		EndUpdate();
+
+	void		paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+	QSize		sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+
+protected:
+	struct SHistory
+	{
+		SHistory() : Tag(0), Last(0), Count(0), Capacity(0) {}
+
+		quint64			Tag;
+		quint64			Last;		// tick of the newest sample
+		int				Count;		// valid samples
+		int				Capacity;
+		QVector<quint8>	Samples;	// one byte per value, the sample of tick t is at (t % Capacity)
+	};
+
+	struct SColumn
+	{
+		QVector<QRgb>				Colors;
+		QRgb						BkG;
+		QHash<quint64, SHistory>	History;
+	};
+
+	static void	Resize(SHistory& History, int Values, int Capacity);
+
+	QAbstractItemDelegate*	m_pBaseDelegate;
+	QMap<int, SColumn>		m_Columns;
+	quint64					m_Tick;
+
+	mutable QImage			m_Scratch;
+};
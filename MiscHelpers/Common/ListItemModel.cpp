@@ -180,6 +180,17 @@ QVariant CListItemModel::data(const QModelIndex &index, int role) const
     return Data(index, role, index.column());
 }
 
+bool CListItemModel::SortLessThan(const QModelIndex& left, const QModelIndex& right, Qt::CaseSensitivity cs, bool& bLess) const
+{
+	SListNode* pLeft = static_cast<SListNode*>(left.internalPointer());
+	SListNode* pRight = static_cast<SListNode*>(right.internalPointer());
+	int section = left.column();
+	if (!pLeft || !pRight || pLeft->Values.size() <= section || pRight->Values.size() <= section)
+		return false;
+
+	return CompareSortKeys(pLeft->Values[section].Raw, pRight->Values[section].Raw, cs, bLess);
+}
+
 QVariant CListItemModel::Data(const QModelIndex &index, int role, int section) const
 {
 	if (!index.isValid())
@@ -195,7 +206,13 @@ QVariant CListItemModel::Data(const QModelIndex &index, int role, int section) c
 		case Qt::DisplayRole:
 		{
 			SListNode::SValue& Value = pNode->Values[section];
-			return Value.Formated.isValid() ? Value.Formated : Value.Raw;
+			if (!Value.Formated.IsSet() && Value.IsNumber())
+			{
+				QString Text = FormatCell(pNode, section);
+				if (!Text.isNull())
+					Value.Formated = Text;
+			}
+			return Value.Formated.IsSet() ? QVariant(Value.Formated.Get()) : Value.Raw;
 		}
 		case Qt::EditRole: // sort role
 		{
@@ -1,5 +1,6 @@
 #pragma once
 #include "TreeViewEx.h"
+#include "NodePool.h"
 
 #include "../mischelpers_global.h"
 
@@ -18,6 +19,8 @@ public:
 
 	QVariant		Data(const QModelIndex &index, int role, int section) const;
 
+	virtual bool	SortLessThan(const QModelIndex& left, const QModelIndex& right, Qt::CaseSensitivity cs, bool& bLess) const;
+
 	// derived functions
     virtual QVariant		data(const QModelIndex &index, int role) const;
     virtual Qt::ItemFlags	flags(const QModelIndex &index) const;
@@ -47,21 +50,21 @@ protected:
 		{
 		}
 
+		static void* operator new(size_t Size)				{ return CNodePool::Alloc(Size); }
+		static void operator delete(void* pMem, size_t Size)	{ CNodePool::Free(pMem, Size); }
+
 		QVariant			ID;
 
 		QVariant			Icon;
 		bool				IsBold;
 		bool				IsGray;
 		QColor				Color;
-		struct SValue
-		{
-			QVariant Raw;
-			QVariant Formated;
-		};
+		typedef SCellValue	SValue;
 		QVector<SValue>		Values;
 	};
 
 	virtual SListNode* MkNode(const QVariant& Id) = 0; // { return new SListNode(Id); }
+	virtual QString FormatCell(SListNode* pNode, int section) const { return QString(); } // a null text shows the number itself
 
 	void Sync(QList<SListNode*>& New, QHash<QVariant, SListNode*>& Old);
 
@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "NodePool.h"
+
+#define NODE_POOL_ALIGN		16
+#define NODE_POOL_MAX_SIZE	1024 // larger nodes are taken directly from the heap
+#define NODE_POOL_CHUNK		64
+
+struct SNodePool
+{
+	SNodePool() { memset(pFree, 0, sizeof(pFree)); }
+
+	QMutex		Mutex;
+	void*		pFree[NODE_POOL_MAX_SIZE / NODE_POOL_ALIGN + 1];
+};
+
+static SNodePool& NodePool()
+{
+	// Note: this is never freed, nodes may still be released after the static destructors ran
+	static SNodePool* pPool = new SNodePool();
+	return *pPool;
+}
+
+void* CNodePool::Alloc(size_t Size)
+{
+	if (Size > NODE_POOL_MAX_SIZE)
+		return ::operator new(Size);
+
+	size_t Class = (Size + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN;
+	SNodePool& Pool = NodePool();
+	QMutexLocker Locker(&Pool.Mutex);
+	if (!Pool.pFree[Class])
+	{
+		size_t SlotSize = Class * NODE_POOL_ALIGN;
+		char* pChunk = (char*)::operator new(SlotSize * NODE_POOL_CHUNK);
+		for (int i = 0; i < NODE_POOL_CHUNK; i++)
+		{
+			void* pSlot = pChunk + i * SlotSize;
+			*(void**)pSlot = Pool.pFree[Class];
+			Pool.pFree[Class] = pSlot;
+		}
+	}
+	void* pMem = Pool.pFree[Class];
+	Pool.pFree[Class] = *(void**)pMem;
+	return pMem;
+}
+
+void CNodePool::Free(void* pMem, size_t Size)
+{
+	if (!pMem)
+		return;
+
+	if (Size > NODE_POOL_MAX_SIZE)
+	{
+		::operator delete(pMem);
+		return;
+	}
+
+	size_t Class = (Size + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN;
+	SNodePool& Pool = NodePool();
+	QMutexLocker Locker(&Pool.Mutex);
+	*(void**)pMem = Pool.pFree[Class];
+	Pool.pFree[Class] = pMem;
+}
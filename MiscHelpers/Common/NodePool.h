@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../mischelpers_global.h"
+
+// A free list allocator for the nodes of the item models, a sync of a large model creates and deletes many nodes,
+// released nodes are kept for reuse, grouped by their size. The memory is never given back to the heap.
+class MISCHELPERS_EXPORT CNodePool
+{
+public:
+	static void*	Alloc(size_t Size);
+	static void		Free(void* pMem, size_t Size);
+};
@@ -0,0 +1,126 @@
+#include "stdafx.h"
+#include "SortFilterProxyModel.h"
+
+void CSortFilterProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+	if (QAbstractItemModel* pOldModel = this->sourceModel())
+	{
+		disconnect(pOldModel, SIGNAL(dataChanged(const QModelIndex&, const QModelIndex&, const QVector<int>&)), this, SLOT(OnSourceDataChanged(const QModelIndex&, const QModelIndex&, const QVector<int>&)));
+		disconnect(pOldModel, SIGNAL(rowsInserted(const QModelIndex&, int, int)), this, SLOT(OnSourceRowsInserted(const QModelIndex&, int, int)));
+		disconnect(pOldModel, SIGNAL(rowsAboutToBeRemoved(const QModelIndex&, int, int)), this, SLOT(OnSourceRowsAboutToBeRemoved(const QModelIndex&, int, int)));
+		disconnect(pOldModel, SIGNAL(rowsMoved(const QModelIndex&, int, int, const QModelIndex&, int)), this, SLOT(OnSourceReset()));
+		disconnect(pOldModel, SIGNAL(modelReset()), this, SLOT(OnSourceReset()));
+	}
+
+	m_FilterCache.clear();
+	m_pModelEx = qobject_cast<QAbstractItemModelEx*>(sourceModel);
+
+	// Note: we connect before QSortFilterProxyModel does, so the cache is up to date by the time it re-filters the changed rows
+	if (sourceModel)
+	{
+		connect(sourceModel, SIGNAL(dataChanged(const QModelIndex&, const QModelIndex&, const QVector<int>&)), this, SLOT(OnSourceDataChanged(const QModelIndex&, const QModelIndex&, const QVector<int>&)));
+		connect(sourceModel, SIGNAL(rowsInserted(const QModelIndex&, int, int)), this, SLOT(OnSourceRowsInserted(const QModelIndex&, int, int)));
+		connect(sourceModel, SIGNAL(rowsAboutToBeRemoved(const QModelIndex&, int, int)), this, SLOT(OnSourceRowsAboutToBeRemoved(const QModelIndex&, int, int)));
+		connect(sourceModel, SIGNAL(rowsMoved(const QModelIndex&, int, int, const QModelIndex&, int)), this, SLOT(OnSourceReset()));
+		connect(sourceModel, SIGNAL(modelReset()), this, SLOT(OnSourceReset()));
+	}
+
+	QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void CSortFilterProxyModel::CheckFilterCache() const
+{
+	// Note: all filter setters of QSortFilterProxyModel re-filter right away, hence this is the one place which sees each change first,
+	//			the case sensitivity as well as fixed strings and wildcards are part of the reg exp
+	if (m_CacheKeyColumn == filterKeyColumn() && m_CacheRole == filterRole() && m_bCacheHighLight == m_bHighLight && m_CacheRegExp == filterRegExp())
+		return;
+
+	m_FilterCache.clear();
+	m_CacheRegExp = filterRegExp();
+	m_CacheKeyColumn = filterKeyColumn();
+	m_CacheRole = filterRole();
+	m_bCacheHighLight = m_bHighLight;
+}
+
+bool CSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex & source_parent) const
+{
+	if (m_pModelEx)
+		CheckFilterCache();
+
+	if (m_bHighLight)
+		return true;
+
+	if (filterRegExp().isEmpty() || !m_pModelEx)
+		return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+
+	// get source-model index for current row
+	QModelIndex source_index = sourceModel()->index(source_row, 0, source_parent);
+	if (!source_index.isValid())
+		return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+
+	// Note: with recursive filtering the proxy asks for every row of a rejected subtree, the match of the row itself is cached
+	QHash<quintptr, quint8>::iterator I = m_FilterCache.find(source_index.internalId());
+	if (I != m_FilterCache.end())
+		return (I.value() & eSelfAccepted) != 0;
+
+	bool bAccepted = QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+	m_FilterCache.insert(source_index.internalId(), eSelfKnown | (bAccepted ? eSelfAccepted : 0));
+	return bAccepted;
+}
+
+void CSortFilterProxyModel::invalidateFilter()
+{
+	m_FilterCache.clear();
+	QSortFilterProxyModel::invalidateFilter();
+}
+
+void CSortFilterProxyModel::OnSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+	if (m_FilterCache.isEmpty() || !topLeft.isValid())
+		return;
+
+	// a change of other roles, like the icons, does not change what the filter sees
+	if (!roles.isEmpty() && !roles.contains(filterRole()) && !roles.contains(Qt::DisplayRole))
+		return;
+
+	// the filtered column did not change, so the cached results are still valid
+	int Column = filterKeyColumn();
+	if (Column != -1 && (Column < topLeft.column() || Column > bottomRight.column()))
+		return;
+
+	// Note: the proxy re-filters the changed rows and their ancestors right after us
+	QModelIndex parent = topLeft.parent();
+	for (int row = topLeft.row(); row <= bottomRight.row(); row++)
+		m_FilterCache.remove(sourceModel()->index(row, 0, parent).internalId());
+}
+
+void CSortFilterProxyModel::OnSourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+	// Note: the node pool may hand out the address of a removed node again, so drop anything we may know under that key
+	if (!m_FilterCache.isEmpty())
+		DropRows(parent, first, last);
+}
+
+void CSortFilterProxyModel::OnSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+	if (!m_FilterCache.isEmpty())
+		DropRows(parent, first, last);
+}
+
+void CSortFilterProxyModel::OnSourceReset()
+{
+	m_FilterCache.clear();
+}
+
+void CSortFilterProxyModel::DropRows(const QModelIndex& parent, int first, int last)
+{
+	for (int row = first; row <= last; row++)
+	{
+		QModelIndex index = sourceModel()->index(row, 0, parent);
+		m_FilterCache.remove(index.internalId());
+
+		int Count = sourceModel()->rowCount(index);
+		if (Count > 0)
+			DropRows(index, 0, Count - 1);
+	}
+}
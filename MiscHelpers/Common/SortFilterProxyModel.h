@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../mischelpers_global.h"
+#include "TreeViewEx.h"
 
 class MISCHELPERS_EXPORT CSortFilterProxyModel: public QSortFilterProxyModel
 {
@@ -11,36 +12,34 @@ public:
 	{
 		m_bAlternate = bAlternate;
 		m_bHighLight = false;
+		m_pModelEx = NULL;
+		m_CacheKeyColumn = -1;
+		m_CacheRole = -1;
+		m_bCacheHighLight = false;
+
+		// Note: a parent is shown if any of its descendants matches, the proxy re-checks the ancestors of changed rows on its own
+		setRecursiveFilteringEnabled(true);
 	}
 
-	bool filterAcceptsRow(int source_row, const QModelIndex & source_parent) const
-	{
-		if (m_bHighLight)
-			return true;
+	void setSourceModel(QAbstractItemModel* sourceModel);
 
-		// allow the item to pass if any of the child items pass
-		if(!filterRegExp().isEmpty())
-		{
-			// get source-model index for current row
-			QModelIndex source_index = sourceModel()->index(source_row, 0, source_parent);
-			if(source_index.isValid())
-			{
-				// if any of children matches the filter, then current index matches the filter as well
-				int nb = sourceModel()->rowCount(source_index);
-				for(int i = 0; i < nb; i++)
-				{
-					if(filterAcceptsRow(i, source_index))
-						return true;
-				}
-				// check current index itself
-				return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
-			}
-		}
+	bool lessThan(const QModelIndex &left, const QModelIndex &right) const
+	{
+		// Note: with dynamic sorting every change of the sort column is re-sorted, the models of this library can compare
+		//			their typed sort keys directly, which saves the data() round trip and the variant dispatch per comparison
+		bool bLess;
+		if (m_pModelEx && sortRole() == Qt::EditRole && !isSortLocaleAware() && m_pModelEx->SortLessThan(left, right, sortCaseSensitivity(), bLess))
+			return bLess;
 
-		// default behavioure
-		return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+		return QSortFilterProxyModel::lessThan(left, right);
 	}
 
+	bool filterAcceptsRow(int source_row, const QModelIndex & source_parent) const;
+
+	// Note: changes of the filter settings of QSortFilterProxyModel are picked up by filterAcceptsRow on its own,
+	//			this hides QSortFilterProxyModel::invalidateFilter only for derived filters which change their own criteria
+	void invalidateFilter();
+
 	QVariant data(const QModelIndex &index, int role) const
 	{
 		QVariant Data = QSortFilterProxyModel::data(index, role);
@@ -76,7 +75,31 @@ public slots:
 		setFilterRegExp(Exp);
 	}
 
+private slots:
+	void		OnSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+	void		OnSourceRowsInserted(const QModelIndex& parent, int first, int last);
+	void		OnSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+	void		OnSourceReset();
+
 protected:
+	enum EFilterState
+	{
+		eSelfKnown = 0x01,
+		eSelfAccepted = 0x02,
+	};
+
+	void		DropRows(const QModelIndex& parent, int first, int last);
+	void		CheckFilterCache() const;
+
 	bool		m_bAlternate;
 	bool		m_bHighLight;
+	QAbstractItemModelEx* m_pModelEx;
+
+	// filter result of the row itself by source node, only used for the models of this library as only they have stable node pointers
+	mutable QHash<quintptr, quint8> m_FilterCache;
+	// the filter settings the cache was filled with
+	mutable QRegExp m_CacheRegExp;
+	mutable int	m_CacheKeyColumn;
+	mutable int	m_CacheRole;
+	mutable bool m_bCacheHighLight;
 };
\ No newline at end of file
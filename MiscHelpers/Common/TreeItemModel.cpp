@@ -128,16 +128,10 @@ void CTreeItemModel::Sync(QMap<QList<QVariant>, QList<STreeNode*> >& New, QHash<
 {
 	Purge(m_Root, QModelIndex(), Old);
 
-	if(!New.isEmpty())
-	{
-		emit layoutAboutToBeChanged();
-
-		//foreach(const QString& Path, New.uniqueKeys())
-		for(QMap<QList<QVariant>, QList<STreeNode*> >::const_iterator I = New.begin(); I != New.end(); I++)
-			Fill(m_Root, QModelIndex(), I.key(), 0, I.value(), I.key());
-
-		emit layoutChanged();
-	}
+	// Note: Fill announces every inserted range on its own, so the proxies and views only have to deal with the new rows
+	//foreach(const QString& Path, New.uniqueKeys())
+	for(QMap<QList<QVariant>, QList<STreeNode*> >::const_iterator I = New.begin(); I != New.end(); I++)
+		Fill(m_Root, QModelIndex(), I.key(), 0, I.value(), I.key());
 
 	emit Updated();
 }
@@ -232,22 +226,24 @@ void CTreeItemModel::Fill(STreeNode* pParent, const QModelIndex &parent, const Q
 			pNode = pParent->Children[i];
 		else
 		{
-			i = 0;
+			i = pParent->Children.count();
 			pNode = MkNode(QVariant());
 			pNode->Parent = pParent;
 			pNode->Values.resize(columnCount());
 
-			//int Count = pParent->Children.count();
-			//beginInsertRows(parent, Count, Count);
-			pParent->Aux.insert(pNode->ID, pParent->Children.size());
-			pNode->Row = pParent->Children.size();
+			beginInsertRows(parent, i, i);
+			pParent->Aux.insert(pNode->ID, i);
+			pNode->Row = i;
 			pParent->Children.append(pNode);
-			//endInsertRows();
+			endInsertRows();
 		}
 		Fill(pNode, index(i, 0, parent), Paths, PathsIndex + 1, New, Path);
 	}
-	else
+	else if(!New.isEmpty())
 	{
+		// all new nodes of one parent are appended as one range
+		int Count = pParent->Children.count();
+		beginInsertRows(parent, Count, Count + New.count() - 1);
 		for(QList<STreeNode*>::const_iterator I = New.begin(); I != New.end(); I++)
 		{
 			STreeNode* pNode = *I;
@@ -256,13 +252,11 @@ void CTreeItemModel::Fill(STreeNode* pParent, const QModelIndex &parent, const Q
 			m_Map.insert(pNode->ID, pNode);
 			pNode->Parent = pParent;
 
-			//int Count = pParent->Children.count();
-			//beginInsertRows(parent, Count, Count);
 			pParent->Aux.insert(pNode->ID, pParent->Children.size());
 			pNode->Row = pParent->Children.size();
 			pParent->Children.append(pNode);
-			//endInsertRows();
 		}
+		endInsertRows();
 	}
 }
 
@@ -353,6 +347,17 @@ QVariant CTreeItemModel::Data(const QModelIndex &index, int role, int section) c
 	return NodeData(pNode, role, section);
 }
 
+bool CTreeItemModel::SortLessThan(const QModelIndex& left, const QModelIndex& right, Qt::CaseSensitivity cs, bool& bLess) const
+{
+	STreeNode* pLeft = static_cast<STreeNode*>(left.internalPointer());
+	STreeNode* pRight = static_cast<STreeNode*>(right.internalPointer());
+	int section = left.column();
+	if (!pLeft || !pRight || pLeft->Values.size() <= section || pRight->Values.size() <= section)
+		return false;
+
+	return CompareSortKeys(pLeft->Values[section].Raw, pRight->Values[section].Raw, cs, bLess);
+}
+
 QVariant CTreeItemModel::NodeData(STreeNode* pNode, int role, int section) const
 {
     switch(role)
@@ -360,12 +365,17 @@ QVariant CTreeItemModel::NodeData(STreeNode* pNode, int role, int section) const
 		case Qt::DisplayRole:
 		{
 			STreeNode::SValue& Value = pNode->Values[section];
-			return Value.Formated.isValid() ? Value.Formated : Value.Raw;
+			if (!Value.Formated.IsSet() && Value.IsNumber())
+			{
+				QString Text = FormatCell(pNode, section);
+				if (!Text.isNull())
+					Value.Formated = Text;
+			}
+			return Value.Formated.IsSet() ? QVariant(Value.Formated.Get()) : Value.Raw;
 		}
 		case Qt::EditRole: // sort role
 		{
-			STreeNode::SValue& value = pNode->Values[section];
-			return value.SortKey.isValid() ? value.SortKey : value.Raw;
+			return pNode->Values[section].Raw;
 		}
 		case Qt::ToolTipRole:
 		{
@@ -467,10 +477,9 @@ QModelIndex CTreeItemModel::parent(const QModelIndex &index) const
     if (pParent == m_Root)
         return QModelIndex();
 
-	int row = 0;
-	if(pParent->Parent)
-		row = pParent->Parent->Children.indexOf(pParent);
-    return createIndex(row, 0, pParent);
+	// Note: Row is kept up to date by Fill and Purge, hence there is no need to search the siblings
+	ASSERT(pParent->Parent->Children[pParent->Row] == pParent);
+    return createIndex(pParent->Row, 0, pParent);
 }
 
 int CTreeItemModel::rowCount(const QModelIndex &parent) const
@@ -1,5 +1,6 @@
 #pragma once
 #include "TreeViewEx.h"
+#include "NodePool.h"
 
 #include "../mischelpers_global.h"
 
@@ -22,6 +23,8 @@ public:
 
 	QVariant		Data(const QModelIndex &index, int role, int section) const;
 
+	virtual bool	SortLessThan(const QModelIndex& left, const QModelIndex& right, Qt::CaseSensitivity cs, bool& bLess) const;
+
 	// derived functions
     virtual QVariant		data(const QModelIndex &index, int role) const;
 	virtual bool			setData(const QModelIndex &index, const QVariant &value, int role);
@@ -57,6 +60,9 @@ protected:
 				delete pNode;
 		}
 
+		static void* operator new(size_t Size)				{ return CNodePool::Alloc(Size); }
+		static void operator delete(void* pMem, size_t Size)	{ CNodePool::Free(pMem, Size); }
+
 		QVariant			ID;
 
 		STreeNode*			Parent;
@@ -70,16 +76,12 @@ protected:
 		bool				IsBold;
 		bool				IsGray;
 		QColor				Color;
-		struct SValue
-		{
-			QVariant Raw;
-			QVariant SortKey;
-			QVariant Formated;
-		};
+		typedef SCellValue	SValue;
 		QVector<SValue>		Values;
 	};
 
 	virtual QVariant	NodeData(STreeNode* pNode, int role, int section) const;
+	virtual QString		FormatCell(STreeNode* pNode, int section) const { return QString(); } // a null text shows the number itself
 
 	virtual STreeNode*	MkNode(const QVariant& Id) = 0; // { return new STreeNode(Id); }
 
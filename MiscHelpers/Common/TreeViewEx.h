@@ -94,7 +94,58 @@ public:
 			m_Columns.insert(column);
 	}
 
+	// lets the sort proxy compare the sort keys of two rows directly, returns false if it can't tell, then the proxy uses data()
+	virtual bool SortLessThan(const QModelIndex& left, const QModelIndex& right, Qt::CaseSensitivity cs, bool& bLess) const { return false; }
+
 protected:
+	static bool CompareSortKeys(const QVariant& Left, const QVariant& Right, Qt::CaseSensitivity cs, bool& bLess)
+	{
+		// Note: mixed or unusual types are left to the generic variant comparison of the proxy
+		if (Left.userType() != Right.userType())
+			return false;
+
+		switch (Left.userType())
+		{
+			case QMetaType::Int:		bLess = *(const int*)Left.constData() < *(const int*)Right.constData(); return true;
+			case QMetaType::UInt:		bLess = *(const uint*)Left.constData() < *(const uint*)Right.constData(); return true;
+			case QMetaType::LongLong:	bLess = *(const qlonglong*)Left.constData() < *(const qlonglong*)Right.constData(); return true;
+			case QMetaType::ULongLong:	bLess = *(const qulonglong*)Left.constData() < *(const qulonglong*)Right.constData(); return true;
+			case QMetaType::Double:		bLess = *(const double*)Left.constData() < *(const double*)Right.constData(); return true;
+			case QMetaType::Float:		bLess = *(const float*)Left.constData() < *(const float*)Right.constData(); return true;
+			case QMetaType::QString:	bLess = QString::compare(*(const QString*)Left.constData(), *(const QString*)Right.constData(), cs) < 0; return true;
+			default:					return false;
+		}
+	}
+
+	// the display text of a cell, the cell shows its raw value until a text is assigned, an empty or null one included
+	struct SCellText
+	{
+		SCellText& operator=(const QString& Text)	{ m_Text = Text.isNull() ? QString("") : Text; return *this; }
+		bool			IsSet() const				{ return !m_Text.isNull(); }
+		const QString&	Get() const					{ return m_Text; }
+		void			Clear()						{ m_Text = QString(); }
+
+	private:
+		QString			m_Text;
+	};
+
+	// a cell value, numbers are kept in their own type in place and get their text only once the cell is displayed, see FormatCell
+	struct SCellValue
+	{
+		template <class T>
+		void			SetNumber(T Value)			{ Raw.setValue<T>(Value); Formated.Clear(); }
+		bool			IsNumber() const
+		{
+			switch (Raw.userType())
+			{
+				case QMetaType::Int: case QMetaType::UInt: case QMetaType::LongLong: case QMetaType::ULongLong: case QMetaType::Double: return true;
+				default: return false;
+			}
+		}
+
+		QVariant		Raw;
+		SCellText		Formated;
+	};
 
 	QSet<int>				m_Columns;
 };
@@ -10,6 +10,7 @@
 #include ".\Common\Finder.h"
 #include ".\Common\FlexError.h"
 #include ".\Common\FlowLayout.h"
+#include ".\Common\HistoryDelegate.h"
 #include ".\Common\HistoryGraph.h"
 #include ".\Common\ItemChooser.h"
 #include ".\Common\KeyValueInputDialog.h"
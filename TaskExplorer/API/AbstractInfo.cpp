@@ -6,8 +6,7 @@
 volatile quint64 CAbstractInfoEx::m_PersistenceTime = 5000;
 volatile quint64 CAbstractInfoEx::m_HighlightTime = 2500;
 
-CAbstractInfoEx::CAbstractInfoEx(QObject *parent)
-	: CAbstractInfo(parent)
+CAbstractInfoEx::CAbstractInfoEx()
 {
 	m_NewlyCreated = true;
 	m_CreateTimeStamp = 0;
@@ -45,3 +44,81 @@ bool CAbstractInfoEx::IsNewlyCreated() const
 	}
 	return m_NewlyCreated;
 }
+
+struct SInfoPoolRegistry
+{
+	QMutex					Mutex;
+	QList<CInfoPoolBase*>	Pools;
+};
+
+static SInfoPoolRegistry* InfoPoolRegistry()
+{
+	// Note: this is never freed, like the pools themselves
+	static SInfoPoolRegistry* pRegistry = new SInfoPoolRegistry();
+	return pRegistry;
+}
+
+CInfoPoolBase::CInfoPoolBase()
+{
+	SInfoPoolRegistry* pRegistry = InfoPoolRegistry();
+	QMutexLocker Locker(&pRegistry->Mutex);
+	pRegistry->Pools.append(this);
+}
+
+void CInfoPoolBase::TrimAll()
+{
+	SInfoPoolRegistry* pRegistry = InfoPoolRegistry();
+	QMutexLocker Locker(&pRegistry->Mutex);
+	foreach(CInfoPoolBase* pPool, pRegistry->Pools)
+		pPool->Trim();
+}
+
+// Note: the table is split in shards by hash, so that the parallel update workers rarely wait on each other
+#define STRING_POOL_SHARDS	16
+
+struct SStringPoolShard
+{
+	QMutex			Mutex;
+	QSet<QString>	Strings;
+};
+
+static SStringPoolShard* StringPoolShards()
+{
+	// Note: this is never freed, interned strings may still be released after the static destructors ran
+	static SStringPoolShard* pShards = new SStringPoolShard[STRING_POOL_SHARDS];
+	return pShards;
+}
+
+QString CStringPool::Intern(const QString& String)
+{
+	if (String.isEmpty())
+		return String;
+
+	SStringPoolShard& Shard = StringPoolShards()[qHash(String) % STRING_POOL_SHARDS];
+	QMutexLocker Locker(&Shard.Mutex);
+	QSet<QString>::const_iterator I = Shard.Strings.constFind(String);
+	if (I != Shard.Strings.constEnd())
+		return *I;
+
+	// the string may come from a larger buffer, don't keep the slack around for the lifetime of the entry
+	QString Copy = String;
+	Copy.squeeze();
+	Shard.Strings.insert(Copy);
+	return Copy;
+}
+
+void CStringPool::Purge()
+{
+	SStringPoolShard* pShards = StringPoolShards();
+	for (int i = 0; i < STRING_POOL_SHARDS; i++)
+	{
+		QMutexLocker Locker(&pShards[i].Mutex);
+		for (QSet<QString>::iterator I = pShards[i].Strings.begin(); I != pShards[i].Strings.end();)
+		{
+			if (I->isDetached()) // only the pool still references it
+				I = pShards[i].Strings.erase(I);
+			else
+				++I;
+		}
+	}
+}
@@ -1,13 +1,14 @@
 #pragma once
 #include <qobject.h>
+#include <type_traits>
 #include "../../MiscHelpers/Common/Common.h"
 
-class CAbstractInfo : public QObject
+// Note: this is not a QObject, the per item records like handles or memory regions exist in large numbers,
+// classes which need signals, slots or a parent derive from QObject in addition, it must be the first base
+class CAbstractInfo
 {
-	Q_OBJECT
-
 public:
-	CAbstractInfo(QObject *parent = nullptr) : QObject(parent) {}
+	CAbstractInfo() {}
 	virtual ~CAbstractInfo() {}
 
 	mutable QReadWriteLock		m_Mutex;
@@ -16,10 +17,8 @@ public:
 
 class CAbstractInfoEx : public CAbstractInfo
 {
-	Q_OBJECT
-
 public:
-	CAbstractInfoEx(QObject *parent = nullptr);
+	CAbstractInfoEx();
 	virtual ~CAbstractInfoEx();
 
 	static void					SetHighlightTime(quint64 time)		{ m_HighlightTime = time; }
@@ -43,4 +42,149 @@ protected:
 
 	static volatile quint64		m_PersistenceTime;
 	static volatile quint64		m_HighlightTime;
+};
+
+
+// The pools of all record types register here, so that the housekeeping can return their unused chunks without knowing the types
+class CInfoPoolBase
+{
+public:
+	static void TrimAll(); // called along with CStringPool::Purge once processes are gone
+
+protected:
+	CInfoPoolBase();
+	virtual ~CInfoPoolBase() {}
+
+	virtual void	Trim() = 0;
+};
+
+// Allocates the records of one type in chunks and recycles the freed slots, this saves the heap overhead
+// for the types which exist in large numbers and come and go with every refresh, like handles or memory regions.
+// Note: the pool is shared by all processes, as the records may outlive their process object,
+//			chunks which got entirely free are returned to the heap by Trim
+template <class T>
+class CInfoPool : public CInfoPoolBase
+{
+public:
+	template <class... Args>
+	static QSharedPointer<T> New(Args&&... args)
+	{
+		void* pSlot = Instance().Alloc();
+		return QSharedPointer<T>(new (pSlot) T(std::forward<Args>(args)...), &CInfoPool::Delete);
+	}
+
+protected:
+	union SSlot
+	{
+		SSlot*		pNext;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type Data;
+	};
+
+	enum { eChunkSize = 256 };
+
+	CInfoPool() : m_pFree(NULL), m_FreeCount(0) {}
+
+	static CInfoPool& Instance()
+	{
+		// Note: this is never freed, records may still be released after the static destructors ran
+		static CInfoPool* pPool = new CInfoPool();
+		return *pPool;
+	}
+
+	void* Alloc()
+	{
+		QMutexLocker Locker(&m_Mutex);
+		if (!m_pFree)
+		{
+			SSlot* pChunk = new SSlot[eChunkSize];
+			for (int i = 0; i < eChunkSize; i++)
+			{
+				pChunk[i].pNext = m_pFree;
+				m_pFree = &pChunk[i];
+			}
+			m_Chunks.insert((quintptr)pChunk, pChunk);
+			m_FreeCount += eChunkSize;
+		}
+		SSlot* pSlot = m_pFree;
+		m_pFree = pSlot->pNext;
+		m_FreeCount--;
+		return pSlot;
+	}
+
+	static void Delete(T* pItem)
+	{
+		pItem->~T();
+
+		CInfoPool& Pool = Instance();
+		QMutexLocker Locker(&Pool.m_Mutex);
+		SSlot* pSlot = reinterpret_cast<SSlot*>(pItem);
+		pSlot->pNext = Pool.m_pFree;
+		Pool.m_pFree = pSlot;
+		Pool.m_FreeCount++;
+	}
+
+	SSlot* ChunkOf(SSlot* pSlot) const
+	{
+		// the chunk starting at or before the slot
+		typename QMap<quintptr, SSlot*>::const_iterator I = m_Chunks.upperBound((quintptr)pSlot);
+		ASSERT(I != m_Chunks.constBegin());
+		return (--I).value();
+	}
+
+	virtual void Trim()
+	{
+		QMutexLocker Locker(&m_Mutex);
+		// Note: one free chunk is kept as spare, the records come and go with every refresh
+		if (m_FreeCount < 2 * eChunkSize)
+			return;
+
+		QHash<SSlot*, int> FreeSlots;
+		for (SSlot* pSlot = m_pFree; pSlot; pSlot = pSlot->pNext)
+			FreeSlots[ChunkOf(pSlot)]++;
+
+		QSet<SSlot*> Released;
+		bool bSpare = true;
+		for (typename QHash<SSlot*, int>::const_iterator I = FreeSlots.constBegin(); I != FreeSlots.constEnd(); ++I)
+		{
+			if (I.value() != eChunkSize)
+				continue;
+			if (bSpare)
+				bSpare = false;
+			else
+				Released.insert(I.key());
+		}
+		if (Released.isEmpty())
+			return;
+
+		// unlink the slots of the released chunks from the free list
+		for (SSlot** ppSlot = &m_pFree; *ppSlot;)
+		{
+			if (Released.contains(ChunkOf(*ppSlot)))
+				*ppSlot = (*ppSlot)->pNext;
+			else
+				ppSlot = &(*ppSlot)->pNext;
+		}
+
+		foreach(SSlot* pChunk, Released)
+		{
+			m_Chunks.remove((quintptr)pChunk);
+			delete[] pChunk;
+		}
+		m_FreeCount -= Released.size() * eChunkSize;
+	}
+
+	QMutex					m_Mutex;
+	SSlot*					m_pFree;
+	int						m_FreeCount;
+	QMap<quintptr, SSlot*>	m_Chunks; // by start address
+};
+
+// Process wide table of interned strings, names, user names and paths repeat across many processes and modules,
+// the interned copies share one buffer so they cost one allocation and compare equal without looking at the characters.
+// Note: a QString is already reference counted, the pool holds one reference and Purge drops the entries no one else holds
+class CStringPool
+{
+public:
+	static QString Intern(const QString& String);
+	static void Purge();
 };
\ No newline at end of file
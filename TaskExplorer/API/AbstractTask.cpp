@@ -41,7 +41,7 @@ void STaskStats::UpdateStats(quint64 sysTotalTime, quint64 sysTotalCycleTime)
 }
 
 CAbstractTask::CAbstractTask(QObject *parent)
-	: CAbstractInfoEx(parent)
+	: QObject(parent)
 {
 	m_KernelTime = 0;
 	m_UserTime = 0;
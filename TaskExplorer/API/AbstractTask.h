@@ -27,6 +27,23 @@ struct STimeUsage
 	float			Usage; 
 };
 
+// flat copy of the current values of STaskStats
+struct STaskSample
+{
+	float			CpuUsage; 
+	float			CpuKernelUsage;
+	float			CpuUserUsage;
+
+	quint64			CpuKernelTime;
+	quint64			CpuKernelTimeDelta;
+	quint64			CpuUserTime;
+	quint64			CpuUserTimeDelta;
+	quint64			Cycles;
+	quint64			CyclesDelta;
+	quint64			ContextSwitches;
+	quint64			ContextSwitchesDelta;
+};
+
 struct STaskStats
 {
 	STaskStats()
@@ -38,6 +55,21 @@ struct STaskStats
 
 	void			UpdateStats(quint64 sysTotalTime, quint64 sysTotalCycleTime = 0);
 
+	void			GetSample(STaskSample& Sample) const
+	{
+		Sample.CpuUsage = CpuUsage;
+		Sample.CpuKernelUsage = CpuKernelUsage;
+		Sample.CpuUserUsage = CpuUserUsage;
+		Sample.CpuKernelTime = CpuKernelDelta.Value;
+		Sample.CpuKernelTimeDelta = CpuKernelDelta.Delta;
+		Sample.CpuUserTime = CpuUserDelta.Value;
+		Sample.CpuUserTimeDelta = CpuUserDelta.Delta;
+		Sample.Cycles = CycleDelta.Value;
+		Sample.CyclesDelta = CycleDelta.Delta;
+		Sample.ContextSwitches = ContextSwitchesDelta.Value;
+		Sample.ContextSwitchesDelta = ContextSwitchesDelta.Delta;
+	}
+
 	SDelta64 		CpuKernelDelta;
 	SDelta64 		CpuUserDelta;
 	SDelta64 		CycleDelta;
@@ -48,7 +80,7 @@ struct STaskStats
 	float			CpuUserUsage;
 };
 
-class CAbstractTask : public CAbstractInfoEx
+class CAbstractTask : public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
@@ -29,7 +29,7 @@ QList<QHostAddress> CDnsLogEntry::UpdateAddresses(const QList<QHostAddress>& Add
 /////////////////////////////////
 //
 
-CDnsCacheEntry::CDnsCacheEntry(const QString& HostName, quint16 Type, const QHostAddress& Address, const QString& ResolvedString, QObject *parent) : CAbstractInfoEx(parent)
+CDnsCacheEntry::CDnsCacheEntry(const QString& HostName, quint16 Type, const QHostAddress& Address, const QString& ResolvedString, QObject *parent) : QObject(parent)
 {
 	m_CreateTimeStamp = GetTime() * 1000;
 
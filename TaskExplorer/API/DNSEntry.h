@@ -4,8 +4,6 @@
 
 class CDnsLogEntry: public CAbstractInfoEx
 {
-	Q_OBJECT
-
 public:
 	CDnsLogEntry(const QString& HostName, const QList<QHostAddress>& Addresses);
 	virtual ~CDnsLogEntry() {}
@@ -69,7 +67,7 @@ protected:
 typedef QSharedPointer<CDnsProcRecord> CDnsProcRecordPtr;
 */
 
-class CDnsCacheEntry: public CAbstractInfoEx
+class CDnsCacheEntry: public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
@@ -2,7 +2,7 @@
 #include "DriverInfo.h"
 
 
-CDriverInfo::CDriverInfo(QObject *parent) : CAbstractInfoEx(parent)
+CDriverInfo::CDriverInfo(QObject *parent) : QObject(parent)
 {
 }
 
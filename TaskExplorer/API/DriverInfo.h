@@ -4,7 +4,7 @@
 
 #include "ModuleInfo.h"
 
-class CDriverInfo: public CAbstractInfoEx
+class CDriverInfo: public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
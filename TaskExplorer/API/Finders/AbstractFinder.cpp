@@ -8,6 +8,7 @@
 #endif
 
 int _QList_QSharedPointer_QObject_type = qRegisterMetaType<QList<QSharedPointer<QObject> >>("QList<QSharedPointer<QObject> >");
+int _QList_CHandlePtr_type = qRegisterMetaType<QList<CHandlePtr>>("QList<CHandlePtr>");
 
 CAbstractFinder::CAbstractFinder(QObject* parent) : QThread(parent) 
 {
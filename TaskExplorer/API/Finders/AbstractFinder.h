@@ -31,6 +31,7 @@ public:
 signals:
 	void	Progress(float value, const QString& Info = QString());
 	void	Results(QList<QSharedPointer<QObject>> List);
+	void	HandleResults(QList<CHandlePtr> List); // handles are no QObjects
 	void	Error(const QString& Error, int Code);
 	void	Finished();
 
@@ -4,7 +4,7 @@
 #include "SystemAPI.h"
 
 
-CHandleInfo::CHandleInfo(QObject *parent) : CAbstractInfoEx(parent)
+CHandleInfo::CHandleInfo()
 {
 	m_HandleId = -1;
 	m_ProcessId = -1;
@@ -5,10 +5,8 @@
 
 class CHandleInfo: public CAbstractInfoEx
 {
-	Q_OBJECT
-
 public:
-	CHandleInfo(QObject *parent = nullptr);
+	CHandleInfo();
 	virtual ~CHandleInfo();
 
 	virtual quint64 GetHandleId() const				{ QReadLocker Locker(&m_Mutex); return m_HandleId; }
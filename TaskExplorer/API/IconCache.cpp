@@ -0,0 +1,109 @@
+#include "stdafx.h"
+#include "IconCache.h"
+#include "../../MiscHelpers/Common/Settings.h"
+#ifdef WIN32
+#include "Windows/ProcessHacker.h"
+#include <QtWin>
+#endif
+
+
+CIconCache* CIconCache::Instance()
+{
+	// Note: this is never freed, the decode jobs may still be running on exit
+	static CIconCache* pCache = new CIconCache();
+	return pCache;
+}
+
+CIconCache::CIconCache(QObject* parent)
+	: QObject(parent)
+{
+	SetMaxSize(theConf->GetInt("Options/IconCacheSize", 8192));
+
+	// Note: the extraction is mostly disk bound, a few threads are enough and leave the global pool to the update workers
+	m_Pool.setMaxThreadCount(2);
+}
+
+CIconCache::~CIconCache()
+{
+	m_Pool.waitForDone();
+}
+
+void CIconCache::SetMaxSize(int MaxSizeKB)
+{
+	m_Icons.setMaxCost(qMax(MaxSizeKB, 256));
+}
+
+QPixmap CIconCache::GetIcon(const QString& FileName, quint64 ModificationTime, bool bLarge)
+{
+	if (FileName.isEmpty())
+		return QPixmap();
+
+	SIconKey Key(FileName, ModificationTime, bLarge);
+	if (QPixmap* pIcon = m_Icons.object(Key))
+		return *pIcon;
+
+	if (!m_Pending.contains(Key))
+	{
+		m_Pending.insert(Key);
+		QtConcurrent::run(&m_Pool, CIconCache::DecodeIcon, this, Key);
+	}
+	return QPixmap();
+}
+
+void CIconCache::DecodeIcon(CIconCache* This, SIconKey Key)
+{
+	QImage Icon = LoadIcon(Key.FileName, Key.bLarge);
+
+	QMutexLocker Locker(&This->m_DecodedMutex);
+	bool bFirst = This->m_Decoded.isEmpty();
+	This->m_Decoded.append(qMakePair(Key, Icon));
+	Locker.unlock();
+
+	// the results are collected and handed over to the gui thread in batches
+	if (bFirst)
+		QMetaObject::invokeMethod(This, "OnIconsDecoded", Qt::QueuedConnection);
+}
+
+void CIconCache::OnIconsDecoded()
+{
+	QMutexLocker Locker(&m_DecodedMutex);
+	QList<QPair<SIconKey, QImage> > Decoded = m_Decoded;
+	m_Decoded.clear();
+	Locker.unlock();
+
+	for (QList<QPair<SIconKey, QImage> >::iterator I = Decoded.begin(); I != Decoded.end(); ++I)
+	{
+		m_Pending.remove(I->first);
+
+		// Note: files without an icon are cached as well, so we don't try again on every refresh
+		QPixmap* pIcon = new QPixmap(QPixmap::fromImage(I->second));
+		int Cost = 1 + I->second.byteCount() / 1024;
+		m_Icons.insert(I->first, pIcon, Cost);
+	}
+
+	if (!Decoded.isEmpty())
+		emit IconsReady();
+}
+
+QImage CIconCache::LoadIcon(const QString& FileName, bool bLarge)
+{
+	QImage Icon;
+#ifdef WIN32
+	PPH_STRING fileName = CastQString(FileName);
+	HICON SmallIcon;
+	HICON LargeIcon;
+	if (PhExtractIcon(fileName->Buffer, &LargeIcon, &SmallIcon))
+	{
+		HICON hIcon = bLarge ? LargeIcon : SmallIcon;
+		if (hIcon)
+			Icon = QtWin::imageFromHICON(hIcon);
+		if (SmallIcon)
+			DestroyIcon(SmallIcon);
+		if (LargeIcon)
+			DestroyIcon(LargeIcon);
+	}
+	PhDereferenceObject(fileName);
+#endif
+	// Note: on linux binaries don't carry an icon
+	return Icon;
+}
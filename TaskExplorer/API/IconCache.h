@@ -0,0 +1,59 @@
+#pragma once
+#include <qobject.h>
+#include <QCache>
+
+struct SIconKey
+{
+	SIconKey(const QString& FileName = QString(), quint64 ModificationTime = 0, bool bLarge = false)
+		: FileName(FileName), ModificationTime(ModificationTime), bLarge(bLarge) {}
+
+	bool operator==(const SIconKey& Other) const {
+		return ModificationTime == Other.ModificationTime && bLarge == Other.bLarge && FileName == Other.FileName;
+	}
+
+	QString			FileName;
+	quint64			ModificationTime;
+	bool			bLarge;
+};
+
+inline uint qHash(const SIconKey& Key, uint Seed = 0)
+{
+	return qHash(Key.FileName, Seed) ^ qHash(Key.ModificationTime, Seed) ^ (uint)Key.bLarge;
+}
+
+// Process wide cache of the icons of executables and libraries, keyed by file and modification time.
+// The icons are extracted on a background pool and the cache is bounded by the Options/IconCacheSize budget (in KB),
+// the least recently used icons are dropped first.
+// Note: QPixmap may only be used on the GUI thread, so GetIcon must only be called from there.
+class CIconCache : public QObject
+{
+	Q_OBJECT
+public:
+	static CIconCache* Instance();
+
+	// Returns the cached icon, a null pixmap if the file has none, or if it was not loaded yet, 
+	// in the later case the extraction is queued and IconsReady is emitted once it is done
+	QPixmap			GetIcon(const QString& FileName, quint64 ModificationTime, bool bLarge = false);
+
+	void			SetMaxSize(int MaxSizeKB);
+
+signals:
+	void			IconsReady();
+
+private slots:
+	void			OnIconsDecoded();
+
+protected:
+	CIconCache(QObject* parent = NULL);
+	virtual ~CIconCache();
+
+	static void		DecodeIcon(CIconCache* This, SIconKey Key);
+	static QImage	LoadIcon(const QString& FileName, bool bLarge);
+
+	QCache<SIconKey, QPixmap>	m_Icons;
+	QSet<SIconKey>				m_Pending;
+	QThreadPool					m_Pool;
+
+	QMutex						m_DecodedMutex;
+	QList<QPair<SIconKey, QImage> > m_Decoded;
+};
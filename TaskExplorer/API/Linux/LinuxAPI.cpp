@@ -1,34 +1,178 @@
 #include "stdafx.h"
 #include "LinuxAPI.h"
+#include "LinuxProcess.h"
+#include "ProcConnector.h"
+#include "LinuxSocket.h"
+#include "SockDiag.h"
+#include "ProcFileCache.h"
+#include "ProcUring.h"
+#include "ProcParsers.h"
 
 #include "../TaskExplorer/GUI/TaskExplorer.h"
+#include "../../MiscHelpers/Common/Settings.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pwd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 
 ulong g_fileObjectTypeIndex = ULONG_MAX;
 
+#define PROCESS_JOB_BLOCK	16 // processes a worker takes at once
+
+bool ReadProcFile(const char* Path, QByteArray& Buffer)
+{
+	int fd = open(Path, O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	// Note: proc files report a size of 0, so we have to read until EOF
+	Buffer.resize(qMax(Buffer.capacity(), 4096));
+	int Length = 0;
+	for (;;)
+	{
+		ssize_t Read = read(fd, Buffer.data() + Length, Buffer.size() - Length);
+		if (Read <= 0)
+			break;
+		Length += Read;
+		if (Length == Buffer.size())
+			Buffer.resize(Buffer.size() * 2);
+	}
+	close(fd);
+
+	Buffer.resize(Length);
+	return true;
+}
+
 CLinuxAPI::CLinuxAPI(QObject *parent) : CSystemAPI(parent)
 {
+	m_BootTime = 0;
+	m_ClockTicks = 100;
+	m_PageSize = 4096;
+
+	m_pProcConnector = NULL;
+	m_LastFullRescan = 0;
+	m_bProcessListDirty = false;
+
+	m_pProcFiles = new CProcFileCache();
+	m_pUpdatePool = new QThreadPool();
+	m_MaxUpdateWorkers = 1;
+	m_pProcUring = NULL;
+	m_bProcUringFailed = false;
 
+	m_pSockDiag = new CSockDiag();
+	m_LastFdFullScan = 0;
 }
 
 bool CLinuxAPI::Init()
 {
+	m_ClockTicks = sysconf(_SC_CLK_TCK);
+	m_PageSize = sysconf(_SC_PAGESIZE);
+
+	QByteArray Buffer;
+	if (ReadProcFile("/proc/stat", Buffer))
+	{
+		const char* pEnd = Buffer.constData() + Buffer.size();
+		for (const char* pPos = Buffer.constData(); pPos < pEnd; pPos = NextLine(pPos, pEnd))
+		{
+			if (TAKE_KEY(pPos, pEnd, "btime "))
+			{
+				QWriteLocker Locker(&m_Mutex);
+				m_BootTime = ParseULong(pPos, pEnd);
+				break;
+			}
+		}
+	}
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	m_CpuCount = sysconf(_SC_NPROCESSORS_CONF);
+	if (m_CpuCount <= 0)
+		m_CpuCount = 1;
+	m_CpusStats.resize(m_CpuCount);
+
+	m_NumaCount = 1;
+	m_PackageCount = 1;
+	m_CoreCount = m_CpuCount;
+	StatsLocker.unlock();
+
+	// Note: 0 disables the cache, than every file is opened and closed on each read,
+	//			each process needs up to 4 descriptors, processes beyond the budget are read with open, pread and close,
+	//			they also can't be batched with io_uring, so the default covers 16k processes, SetMaxOpen caps it to the rlimit
+	m_pProcFiles->SetMaxOpen(theConf->GetInt("Options/LinuxProcFdCache", 65536));
+
+	if (theConf->GetBool("Options/LinuxProcConnector", true))
+		MonitorProcConnector(true);
+
     return true;
 }
 
 CLinuxAPI::~CLinuxAPI()
 {
-
+	delete m_pUpdatePool;
+	delete m_pProcConnector;
+	delete m_pSockDiag;
+	delete m_pProcUring;
+	delete m_pProcFiles;
 }
 
 bool CLinuxAPI::RootAvaiable()
 {
-    return false;
+    return geteuid() == 0;
+}
+
+QString CLinuxAPI::GetUserNameByID(quint32 UserId)
+{
+	QReadLocker ReadLocker(&m_UserNameMutex);
+	QMap<quint32, QString>::const_iterator I = m_UserNames.find(UserId);
+	if (I != m_UserNames.end())
+		return I.value();
+	ReadLocker.unlock();
+
+	QString UserName;
+	struct passwd Entry;
+	struct passwd* pResult = NULL;
+	char Buffer[1024];
+	if (getpwuid_r(UserId, &Entry, Buffer, sizeof(Buffer), &pResult) == 0 && pResult != NULL)
+		UserName = QString::fromLocal8Bit(pResult->pw_name);
+	else
+		UserName = QString::number(UserId);
+
+	QWriteLocker WriteLocker(&m_UserNameMutex);
+	m_UserNames.insert(UserId, UserName);
+	return UserName;
+}
+
+void CLinuxAPI::MonitorProcConnector(bool bEnable)
+{
+	if (bEnable == (m_pProcConnector != NULL))
+		return;
+
+	if (bEnable)
+	{
+		m_pProcConnector = new CProcConnector();
+
+		connect(m_pProcConnector, SIGNAL(ProcessEvent(int, quint64, quint64, quint64)), this, SLOT(OnProcessEvent(int, quint64, quint64, quint64)));
+		connect(m_pProcConnector, SIGNAL(EventsLost()), this, SLOT(OnProcessEventsLost()));
+
+		if (m_pProcConnector->Init())
+			return;
+	}
+
+	delete m_pProcConnector;
+	m_pProcConnector = NULL;
 }
 
 bool CLinuxAPI::UpdateSysStats()
 {
+	UpdateMemoryStats();
 
+	UpdateVmStats();
 
+	UpdateNetStats();
 
 	QWriteLocker StatsLocker(&m_StatsMutex);
 	m_Stats.UpdateStats();
@@ -36,18 +180,936 @@ bool CLinuxAPI::UpdateSysStats()
 	return true;
 }
 
+quint64 CLinuxAPI::UpdateCpuStats()
+{
+	// Note: we parse the entire /proc/stat in one go, the counters after the cpu lines feed the extended cpu stats
+	if (!ReadProcFile("/proc/stat", m_StatBuffer))
+		return 0;
+
+	QWriteLocker Locker(&m_StatsMutex);
+
+	quint64 totalTime = 0;
+	const char* pEnd = m_StatBuffer.constData() + m_StatBuffer.size();
+	for (const char* pPos = m_StatBuffer.constData(); pPos < pEnd; pPos = NextLine(pPos, pEnd))
+	{
+		if (TAKE_KEY(pPos, pEnd, "cpu"))
+		{
+			SCpuStats* pCpuStats = &m_CpuStats;
+			if (pPos < pEnd && *pPos != ' ')
+			{
+				quint64 Index = ParseULong(pPos, pEnd);
+				if (Index >= (quint64)m_CpusStats.size())
+					continue;
+				pCpuStats = &m_CpusStats[Index];
+			}
+
+			// Fields: cpuN user nice system idle iowait irq softirq steal ...
+			quint64 Fields[8];
+			for (int i = 0; i < 8; i++)
+				Fields[i] = ParseULong(pPos, pEnd);
+
+			// Note: times are given in clock ticks, we use 100ns units like on windows
+			quint64 UserTime = (Fields[0] + Fields[1]) * CPU_TIME_DIVIDER / m_ClockTicks;
+			quint64 KernelTime = (Fields[2] + Fields[5] + Fields[6]) * CPU_TIME_DIVIDER / m_ClockTicks;
+			quint64 IdleTime = (Fields[3] + Fields[4]) * CPU_TIME_DIVIDER / m_ClockTicks;
+
+			pCpuStats->KernelDelta.Update(KernelTime);
+			pCpuStats->UserDelta.Update(UserTime);
+			pCpuStats->IdleDelta.Update(IdleTime);
+
+			quint64 Time = pCpuStats->KernelDelta.Delta + pCpuStats->UserDelta.Delta + pCpuStats->IdleDelta.Delta;
+
+			pCpuStats->KernelUsage = Time != 0 ? (float)pCpuStats->KernelDelta.Delta / Time : 0.0f;
+			pCpuStats->UserUsage = Time != 0 ? (float)pCpuStats->UserDelta.Delta / Time : 0.0f;
+
+			if (pCpuStats == &m_CpuStats)
+			{
+				totalTime = Time;
+
+				// interrupt and softirq time is the closest thing to the windows DPC time
+				m_CpuIrqDelta.Update((Fields[5] + Fields[6]) * CPU_TIME_DIVIDER / m_ClockTicks);
+				m_CpuStatsDPCUsage = Time != 0 ? (float)m_CpuIrqDelta.Delta / Time : 0.0f;
+			}
+		}
+		else if (TAKE_KEY(pPos, pEnd, "intr "))
+			m_CpuStats.InterruptsDelta.Update64(ParseULong(pPos, pEnd)); // the first value is the total
+		else if (TAKE_KEY(pPos, pEnd, "ctxt "))
+			m_CpuStats.ContextSwitchesDelta.Update64(ParseULong(pPos, pEnd));
+		else if (TAKE_KEY(pPos, pEnd, "softirq "))
+			m_CpuStats.DpcsDelta.Update(ParseULong(pPos, pEnd));
+	}
+
+	return totalTime;
+}
+
+void CLinuxAPI::UpdateMemoryStats()
+{
+	if (!ReadProcFile("/proc/meminfo", m_MemInfoBuffer))
+		return;
+
+	enum EMemInfo
+	{
+		eMemTotal = 0,
+		eMemFree,
+		eMemAvailable,
+		eBuffers,
+		eCached,
+		eSwapTotal,
+		eSwapFree,
+		eSReclaimable,
+		eSUnreclaim,
+		eKernelStack,
+		ePageTables,
+		eVmallocUsed,
+		eCommitLimit,
+		eCommitted_AS,
+		eMemInfoCount
+	};
+	static const char* MemInfoKeys[eMemInfoCount] = {
+		"MemTotal", "MemFree", "MemAvailable", "Buffers", "Cached", "SwapTotal", "SwapFree", "SReclaimable",
+		"SUnreclaim", "KernelStack", "PageTables", "VmallocUsed", "CommitLimit", "Committed_AS"
+	};
+
+	quint64 MemInfo[eMemInfoCount];
+	memset(MemInfo, 0, sizeof(MemInfo));
+	quint64 FoundMask = ParseKeyValues(m_MemInfoBuffer.constData(), m_MemInfoBuffer.constData() + m_MemInfoBuffer.size(), MemInfoKeys, eMemInfoCount, MemInfo);
+	for (int i = 0; i < eMemInfoCount; i++)
+		MemInfo[i] *= 1024; // all values are in kB
+
+	// Note: MemAvailable is only present since linux 3.14
+	if ((FoundMask & (1ULL << eMemAvailable)) == 0)
+		MemInfo[eMemAvailable] = MemInfo[eMemFree] + MemInfo[eBuffers] + MemInfo[eCached];
+
+	// swap partitions and files are our page files
+	QList<SPageFile> PageFiles;
+	if (MemInfo[eSwapTotal] != 0 && ReadProcFile("/proc/swaps", m_SwapsBuffer))
+	{
+		QList<SPageFile> OldPageFiles = GetPageFiles();
+
+		const char* pEnd = m_SwapsBuffer.constData() + m_SwapsBuffer.size();
+		// Fields: Filename Type Size Used Priority, the first line is the header
+		for (const char* pPos = NextLine(m_SwapsBuffer.constData(), pEnd); pPos < pEnd; pPos = NextLine(pPos, pEnd))
+		{
+			const char* pPath = pPos;
+			while (pPos < pEnd && *pPos != ' ' && *pPos != '\t')
+				pPos++;
+
+			SPageFile PageFile;
+			// Note: spaces in the path are escaped as \040
+			PageFile.Path = QString::fromLocal8Bit(pPath, pPos - pPath).replace("\\040", " ");
+
+			SkipField(pPos, pEnd); // the type
+
+			PageFile.TotalSize = ParseULong(pPos, pEnd) * 1024;
+			PageFile.TotalInUse = ParseULong(pPos, pEnd) * 1024;
+			PageFile.PeakUsage = PageFile.TotalInUse;
+			foreach(const SPageFile& OldPageFile, OldPageFiles)
+			{
+				if (OldPageFile.Path == PageFile.Path)
+					PageFile.PeakUsage = qMax(PageFile.PeakUsage, OldPageFile.PeakUsage);
+			}
+			PageFiles.append(PageFile);
+		}
+	}
+
+	QWriteLocker Locker(&m_StatsMutex);
+
+	m_InstalledMemory = MemInfo[eMemTotal];
+	m_AvailableMemory = MemInfo[eMemTotal];
+	m_ReservedMemory = 0;
+	m_PhysicalUsed = MemInfo[eMemTotal] - MemInfo[eMemAvailable];
+	m_CacheMemory = MemInfo[eCached] + MemInfo[eBuffers];
+
+	m_CommitedMemory = MemInfo[eCommitted_AS];
+	if (m_CommitedMemoryPeak < m_CommitedMemory)
+		m_CommitedMemoryPeak = m_CommitedMemory;
+	m_MemoryLimit = MemInfo[eCommitLimit];
+
+	// Note: reclaimable slab memory is the closest thing to the paged pool, unreclaimable slab to the non paged pool
+	m_PagedPool = MemInfo[eSReclaimable];
+	m_PersistentPagedPool = 0;
+	m_NonPagedPool = MemInfo[eSUnreclaim];
+	m_KernelMemory = MemInfo[eKernelStack] + MemInfo[ePageTables];
+	m_DriverMemory = MemInfo[eVmallocUsed];
+
+	m_TotalSwapMemory = MemInfo[eSwapTotal];
+	m_SwapedOutMemory = MemInfo[eSwapTotal] - MemInfo[eSwapFree];
+	m_PageFiles = PageFiles;
+}
+
+void CLinuxAPI::UpdateVmStats()
+{
+	if (!ReadProcFile("/proc/vmstat", m_VmStatBuffer))
+		return;
+
+	quint64 PageFaults = 0;
+	quint64 MajorFaults = 0;
+	quint64 PagesIn = 0;
+	quint64 PagesOut = 0;
+	quint64 SwapIn = 0;
+	quint64 SwapOut = 0;
+
+	const char* pEnd = m_VmStatBuffer.constData() + m_VmStatBuffer.size();
+	for (const char* pPos = m_VmStatBuffer.constData(); pPos < pEnd; pPos = NextLine(pPos, pEnd))
+	{
+		if (*pPos != 'p')
+			continue; // all the counters we need start with a p
+
+		if (TAKE_KEY(pPos, pEnd, "pgfault "))			PageFaults = ParseULong(pPos, pEnd);
+		else if (TAKE_KEY(pPos, pEnd, "pgmajfault "))	MajorFaults = ParseULong(pPos, pEnd);
+		else if (TAKE_KEY(pPos, pEnd, "pgpgin "))		PagesIn = ParseULong(pPos, pEnd);
+		else if (TAKE_KEY(pPos, pEnd, "pgpgout "))		PagesOut = ParseULong(pPos, pEnd);
+		else if (TAKE_KEY(pPos, pEnd, "pswpin "))		SwapIn = ParseULong(pPos, pEnd);
+		else if (TAKE_KEY(pPos, pEnd, "pswpout "))		SwapOut = ParseULong(pPos, pEnd);
+	}
+
+	QWriteLocker Locker(&m_StatsMutex);
+
+	m_CpuStats.PageFaultsDelta.Update64(PageFaults);
+	m_CpuStats.PageReadsDelta.Update64(MajorFaults + SwapIn);
+	m_CpuStats.PageFileWritesDelta.Update64(SwapOut);
+
+	// Note: pgpgin/pgpgout are in kB
+	m_Stats.MMapIo.ReadRaw = PagesIn * 1024;
+	m_Stats.MMapIo.WriteRaw = PagesOut * 1024;
+}
+
+void CLinuxAPI::UpdateNetStats()
+{
+	if (!ReadProcFile("/proc/net/dev", m_NetDevBuffer))
+		return;
+
+	quint64 ReceiveBytes = 0;
+	quint64 ReceivePackets = 0;
+	quint64 SendBytes = 0;
+	quint64 SendPackets = 0;
+
+	const char* pEnd = m_NetDevBuffer.constData() + m_NetDevBuffer.size();
+	// the first two lines are the header
+	const char* pPos = NextLine(NextLine(m_NetDevBuffer.constData(), pEnd), pEnd);
+	while (pPos < pEnd)
+	{
+		SProcNetDevEntry Entry;
+		if (!ParseProcNetDevLine(pPos, pEnd, Entry))
+			continue;
+
+		// Note: traffic on the loopback interface never leaves the machine
+		if (Entry.NameLength == 2 && memcmp(Entry.pName, "lo", 2) == 0)
+			continue;
+
+		ReceiveBytes += Entry.ReceiveBytes;
+		ReceivePackets += Entry.ReceivePackets;
+		SendBytes += Entry.SendBytes;
+		SendPackets += Entry.SendPackets;
+	}
+
+	QWriteLocker Locker(&m_StatsMutex);
+
+	// Note: the counters are totals since boot, UpdateStats turns them into deltas and rates
+	m_Stats.Net.SetReceive(ReceiveBytes, ReceivePackets);
+	m_Stats.Net.SetSend(SendBytes, SendPackets);
+}
+
 bool CLinuxAPI::UpdateProcessList()
 {
+	int iLinuxStyleCPU = theConf->GetInt("Options/LinuxStyleCPU", 2);
+
+	quint64 sysTotalTime = UpdateCpuStats(); // total time for this update period
+	quint64 sysTotalTimePerCPU = sysTotalTime / m_CpuCount;
+
+	QSet<quint64> Added;
+	QSet<quint64> Changed;
+	QSet<quint64> Removed;
+
+	// Note: when we get process events from the proc connector we know about new processes already,
+	//			than we only need to list /proc from time to time to be sure we did not miss anything.
+	bool bFullRescan = !m_pProcConnector || GetCurTick() - m_LastFullRescan >= theConf->GetUInt64("Options/LinuxFullRescanInterval", 10000);
+
+	quint32 newTotalProcesses = 0;
+	quint32 newTotalThreads = 0;
+	quint32 newTotalHandles = 0;
+
+	// Copy the process Map
+	// Note: we take the working copy and not the published snapshot, as the events may have added processes which are not yet published
+	QReadLocker OldLocker(&m_ProcessMutex);
+	QMap<quint64, CProcessPtr>	OldProcesses = m_ProcessList;
+	OldLocker.unlock();
+
+	QList<quint64> ProcessIDs;
+	if (bFullRescan)
+	{
+		DIR* pProcDir = opendir("/proc");
+		if (!pProcDir)
+			return false;
+
+		while (struct dirent* pEntry = readdir(pProcDir))
+		{
+			// only the numeric entries are processes
+			if (pEntry->d_name[0] >= '0' && pEntry->d_name[0] <= '9')
+				ProcessIDs.append(strtoull(pEntry->d_name, NULL, 10));
+		}
+
+		closedir(pProcDir);
+
+		m_LastFullRescan = GetCurTick();
+	}
+	else
+	{
+		foreach(const CProcessPtr& pProcess, OldProcesses)
+		{
+			if (!pProcess->IsMarkedForRemoval())
+				ProcessIDs.append(pProcess->GetProcessId());
+		}
+	}
+
+	// Note: the api thread works along with the pool, hence the pool gets one thread less
+	m_MaxUpdateWorkers = qMax(qMin(theConf->GetInt("Options/MaxThreadPool", 10), QThread::idealThreadCount()), 1);
+	m_pUpdatePool->setMaxThreadCount(qMax(m_MaxUpdateWorkers - 1, 1));
+
+	QVector<SProcessJob> Jobs(ProcessIDs.size());
+	for (int i = 0; i < ProcessIDs.size(); i++)
+	{
+		SProcessJob& Job = Jobs[i];
+		Job.ProcessId = ProcessIDs[i];
+		Job.pProcess = OldProcesses.value(Job.ProcessId).staticCast<CLinuxProcess>();
+		Job.BatchState = eBatchNotRead;
+		Job.bRunning = false;
+		Job.bAdded = false;
+		Job.bChanged = false;
+	}
+
+	quint64 sysTime = iLinuxStyleCPU == 1 ? sysTotalTimePerCPU : sysTotalTime;
+
+	// Note: with io_uring we read the stat files of the next batch of processes with a single system call,
+	//			before the batch is handed to the workers, else each worker reads the files itself
+	bool bUseUring = UseProcUring();
+	int ChunkSize = bUseUring ? (int)m_pProcUring->GetEntries() : Jobs.size();
+	QVector<int> BatchStates;
+	for (int Start = 0; Start < Jobs.size(); Start += qMax(ChunkSize, 1))
+	{
+		int Count = qMin(qMax(ChunkSize, 1), Jobs.size() - Start);
+		if (bUseUring)
+		{
+			ReadStatBatch(ProcessIDs, Start, OldProcesses, BatchStates);
+			for (int i = 0; i < BatchStates.size(); i++)
+				Jobs[Start + i].BatchState = BatchStates[i];
+		}
+
+		UpdateProcesses(Jobs, Start, Count, sysTime);
+	}
+
+	// merge the results of all workers
+	QWriteLocker ListLocker(&m_ProcessMutex);
+	foreach(const SProcessJob& Job, Jobs)
+	{
+		// Note: if the stat file can't be read the process has exited in the mean time
+		if (!Job.bRunning)
+			continue;
+
+		// take all running processes out of the copyed map
+		OldProcesses.remove(Job.ProcessId);
+
+		if (Job.bAdded)
+		{
+			if (!Job.pOldProcess.isNull())
+			{
+				// the old process is gone, the new one takes over its pid
+				Job.pOldProcess->MarkForRemoval();
+				Job.pOldProcess->UnInit();
+			}
+			else
+				ASSERT(!m_ProcessList.contains(Job.ProcessId));
+			m_ProcessList.insert(Job.ProcessId, Job.pProcess);
+			Added.insert(Job.ProcessId);
+		}
+		else if (Job.bChanged)
+		{
+			Job.pProcess->MarkDirty(eProcessState);
+			Changed.insert(Job.ProcessId);
+		}
+
+		newTotalProcesses++;
+		newTotalThreads += Job.pProcess->GetNumberOfThreads();
+		newTotalHandles += Job.pProcess->GetNumberOfHandles();
+	}
+	PublishProcessList();
+	m_bProcessListDirty = false;
+	ListLocker.unlock();
+
+	QMap<quint64, CProcessPtr>	Processes = GetProcessList();
+
+	// parent retention
+	QMap<quint64, int> ChildCount;
+	if (theConf->GetBool("Options/EnableParrentRetention", true))
+	{
+		foreach(const CProcessPtr& pProcess, Processes) {
+			CProcessPtr pParent = Processes.value(pProcess->GetParentId());
+			if (!pParent.isNull() && pProcess->ValidateParent(pParent.data()))
+				ChildCount[pProcess->GetParentId()]++;
+		}
+	}
+
+	// purle all processes left as thay are not longer running
+
+	QWriteLocker Locker(&m_ProcessMutex);
+	foreach(quint64 ProcessID, OldProcesses.keys())
+	{
+		QSharedPointer<CLinuxProcess> pProcess = m_ProcessList.value(ProcessID).staticCast<CLinuxProcess>();
+		if (pProcess.isNull())
+			continue;
+
+		if (pProcess->CanBeRemoved() && !ChildCount.contains(ProcessID))
+		{
+			m_ProcessList.remove(ProcessID);
+			Removed.insert(ProcessID);
+		}
+		else if (!pProcess->IsMarkedForRemoval())
+		{
+			m_pProcFiles->Evict(ProcessID);
+			pProcess->MarkForRemoval();
+			pProcess->UnInit();
+			pProcess->MarkDirty(eProcessState);
+			Changed.insert(ProcessID);
+		}
+	}
+	if (!Removed.isEmpty())
+		PublishProcessList();
+	Locker.unlock();
+
+	// include whatever the process events reported since the last update
+	Added.unite(m_EventAdded);
+	Changed.unite(m_EventChanged);
+	m_EventAdded.clear();
+	m_EventChanged.clear();
+
+	CommitProcessChanges();
+
+	// drop the names and paths which were only used by processes that are gone by now, and the record chunks they left empty
+	if (!Removed.isEmpty())
+	{
+		CStringPool::Purge();
+		CInfoPoolBase::TrimAll();
+	}
+
+	emit ProcessListUpdated(Added, Changed, Removed);
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	m_TotalProcesses = newTotalProcesses;
+    m_TotalThreads = newTotalThreads;
+    m_TotalHandles = newTotalHandles;
 
 	return true;
 }
 
+void CLinuxAPI::UpdateProcesses(QVector<SProcessJob>& Jobs, int Start, int Count, quint64 sysTotalTime)
+{
+	// Note: small updates are not worth waking up the pool, each worker should get at least a few blocks
+	int WorkerCount = qMax(qMin(m_MaxUpdateWorkers, Count / (PROCESS_JOB_BLOCK * 4)), 1);
+	if (m_UpdateWorkers.size() < WorkerCount)
+		m_UpdateWorkers.resize(WorkerCount);
+
+	SUpdateContext Context;
+	Context.pJobs = Jobs.data();
+	Context.Start = Start;
+	Context.End = Start + Count;
+	Context.Next = Start;
+	Context.sysTotalTime = sysTotalTime;
+	Context.Demand = GetProcessDemand();
+
+	QList<QFuture<void> > Futures;
+	for (int i = 1; i < WorkerCount; i++)
+		Futures.append(QtConcurrent::run(m_pUpdatePool, this, &CLinuxAPI::UpdateProcessJobs, &Context, &m_UpdateWorkers[i]));
+
+	UpdateProcessJobs(&Context, &m_UpdateWorkers[0]);
+
+	foreach(QFuture<void> Future, Futures)
+		Future.waitForFinished();
+}
+
+void CLinuxAPI::UpdateProcessJobs(SUpdateContext* pContext, SUpdateWorker* pWorker)
+{
+	// Note: the workers take small blocks of jobs from a shared counter, so a worker that hits slow processes
+	//			does not hold up the others, the idle ones just take the remaining blocks
+	for (;;)
+	{
+		int Begin = pContext->Next.fetchAndAddRelaxed(PROCESS_JOB_BLOCK);
+		if (Begin >= pContext->End)
+			break;
+
+		int End = qMin(Begin + PROCESS_JOB_BLOCK, pContext->End);
+		for (int i = Begin; i < End; i++)
+			UpdateProcess(pContext->pJobs[i], i - pContext->Start, pWorker, pContext->sysTotalTime, pContext->Demand);
+	}
+}
+
+void CLinuxAPI::UpdateProcess(SProcessJob& Job, int BatchIndex, SUpdateWorker* pWorker, quint64 sysTotalTime, quint32 Demand)
+{
+	const QByteArray* pStatBuffer = &pWorker->StatBuffer;
+	if (Job.BatchState == eBatchRead)
+		pStatBuffer = &m_StatBatch.at(BatchIndex);
+	else if (Job.BatchState == eBatchGone || !m_pProcFiles->Read(Job.ProcessId, Job.pProcess ? Job.pProcess->GetRawCreateTime() : 0, CProcFileCache::eStat, pWorker->StatBuffer))
+		return;
+
+	SProcStat Stat;
+	if (!ParseProcStat(pStatBuffer->constData(), pStatBuffer->constData() + pStatBuffer->size(), Stat))
+		return;
+
+	// Note: a pid can be reused as soon as the old process got reaped, the start time tells the two apart
+	if (!Job.pProcess.isNull() && Job.pProcess->GetUID() != SProcessUID(Job.ProcessId, Stat.StartTime))
+	{
+		Job.pOldProcess = Job.pProcess;
+		Job.pProcess.clear();
+	}
+
+	if (Job.pProcess.isNull())
+	{
+		QSharedPointer<CLinuxProcess> pProcess = QSharedPointer<CLinuxProcess>(new CLinuxProcess());
+		// Note: the object may have been created on a worker thread, but it must live on the api thread like all others
+		pProcess->moveToThread(thread());
+		if (!pProcess->InitStaticData(Job.ProcessId, Stat))
+			return;
+		Job.pProcess = pProcess;
+		Job.bAdded = true;
+	}
+
+	Job.bRunning = true;
+	Job.bChanged = Job.pProcess->UpdateDynamicData(Stat, m_pProcFiles, pWorker->ProcBuffer, sysTotalTime, Demand);
+}
+
+bool CLinuxAPI::UseProcUring()
+{
+	if (!theConf->GetBool("Options/LinuxUseIoUring", false))
+	{
+		delete m_pProcUring;
+		m_pProcUring = NULL;
+		m_bProcUringFailed = false;
+		return false;
+	}
+
+	if (!m_pProcUring && !m_bProcUringFailed)
+	{
+		m_pProcUring = new CProcUring();
+		m_pProcUring->Init(256);
+	}
+
+	if (m_pProcUring && !m_pProcUring->IsOpen())
+	{
+		// Note: io_uring is not available or the ring failed, we stay with plain pread until the option gets toggled
+		delete m_pProcUring;
+		m_pProcUring = NULL;
+		m_bProcUringFailed = true;
+	}
+
+	return m_pProcUring != NULL;
+}
+
+void CLinuxAPI::ReadStatBatch(const QList<quint64>& ProcessIDs, int Start, const QMap<quint64, CProcessPtr>& Processes, QVector<int>& States)
+{
+	int Count = qMin((int)m_pProcUring->GetEntries(), ProcessIDs.size() - Start);
+	States.fill(eBatchNotRead, Count);
+	if (m_StatBatch.size() < Count)
+		m_StatBatch.resize(Count);
+
+	QVector<CProcUring::SReadRequest> Requests;
+	QVector<int> Indexes;
+	Requests.reserve(Count);
+	Indexes.reserve(Count);
+	for (int i = 0; i < Count; i++)
+	{
+		quint64 ProcessID = ProcessIDs[Start + i];
+		CProcessPtr pProcess = Processes.value(ProcessID);
+		int fd = m_pProcFiles->Open(ProcessID, pProcess ? pProcess->GetRawCreateTime() : 0, CProcFileCache::eStat);
+		if (fd == -1)
+			continue; // the descriptor budget is used up (see Options/LinuxProcFdCache) or the process is gone, let the regular read handle it
+
+		QByteArray& Buffer = m_StatBatch[i];
+		Buffer.resize(qMax(Buffer.capacity(), 4096));
+
+		CProcUring::SReadRequest Request;
+		Request.Fd = fd;
+		Request.pBuffer = Buffer.data();
+		Request.Size = Buffer.size();
+		Request.Result = 0;
+		Requests.append(Request);
+		Indexes.append(i);
+	}
+
+	if (!m_pProcUring->ReadBatch(Requests.data(), Requests.size()))
+		return; // all stay eBatchNotRead and are read with pread
+
+	for (int j = 0; j < Requests.size(); j++)
+	{
+		int i = Indexes[j];
+		int Result = Requests[j].Result;
+		if (Result == -ESRCH)
+		{
+			// Note: once the process has exited its open proc files fail with ESRCH
+			m_pProcFiles->Evict(ProcessIDs[Start + i]);
+			States[i] = eBatchGone;
+		}
+		else if (Result >= 0 && (quint32)Result < Requests[j].Size)
+		{
+			m_StatBatch[i].resize(Result);
+			States[i] = eBatchRead;
+		}
+		// else the buffer was to small or an other error, let pread handle it
+	}
+}
+
+CProcessPtr CLinuxAPI::GetProcessByID(quint64 ProcessId, bool bAddIfNew)
+{
+	QSharedPointer<CLinuxProcess> pProcess = CSystemAPI::GetProcessByID(ProcessId, false).staticCast<CLinuxProcess>();
+	if (!pProcess && bAddIfNew)
+		pProcess = AddProcess(ProcessId, true);
+	return pProcess;
+}
+
+QSharedPointer<CLinuxProcess> CLinuxAPI::FindProcess(quint64 ProcessId, bool bAddIfNew)
+{
+	QReadLocker Locker(&m_ProcessMutex);
+	QSharedPointer<CLinuxProcess> pProcess = m_ProcessList.value(ProcessId).staticCast<CLinuxProcess>();
+	Locker.unlock();
+
+	if (!pProcess && bAddIfNew)
+		pProcess = AddProcess(ProcessId, false);
+	return pProcess;
+}
+
+QSharedPointer<CLinuxProcess> CLinuxAPI::AddProcess(quint64 ProcessId, bool bPublish)
+{
+	char Path[64];
+	QByteArray StatBuffer;
+	sprintf(Path, "/proc/%llu/stat", ProcessId);
+	if (!ReadProcFile(Path, StatBuffer))
+		return QSharedPointer<CLinuxProcess>(); // the process is already gone
+
+	QWriteLocker Locker(&m_ProcessMutex);
+	QSharedPointer<CLinuxProcess> pProcess = m_ProcessList.value(ProcessId).staticCast<CLinuxProcess>();
+	if(pProcess) // just in case between the lookup and QWriteLocker something happened
+		return pProcess;
+
+	pProcess = QSharedPointer<CLinuxProcess>(new CLinuxProcess());
+	pProcess->moveToThread(theAPI->thread());
+	if (!pProcess->InitStaticData(ProcessId, StatBuffer))
+		return QSharedPointer<CLinuxProcess>();
+	m_ProcessList.insert(ProcessId, pProcess);
+	if (bPublish)
+	{
+		PublishProcessList();
+		m_bProcessListDirty = false;
+	}
+	else
+		m_bProcessListDirty = true;
+	return pProcess;
+}
+
+void CLinuxAPI::OnProcessEvent(int Type, quint64 ProcessId, quint64 ParentId, quint64 TimeStamp)
+{
+	bool bFlushPending = !m_EventAdded.isEmpty() || !m_EventChanged.isEmpty() || m_bProcessListDirty;
+
+	switch (Type)
+	{
+		case CProcConnector::eProcessForked:
+		{
+			// Note: the pid may have been reused while the old entry is still being displayed as terminated
+			QSharedPointer<CLinuxProcess> pOldProcess = FindProcess(ProcessId, false);
+			if (pOldProcess && !pOldProcess->IsMarkedForRemoval())
+			{
+				// a rescan may have picked up the new process already, unless its start time differs we are done
+				char Path[64];
+				QByteArray StatBuffer;
+				SProcStat Stat;
+				sprintf(Path, "/proc/%llu/stat", ProcessId);
+				if (!ReadProcFile(Path, StatBuffer) || !ParseProcStat(StatBuffer.constData(), StatBuffer.constData() + StatBuffer.size(), Stat)
+				 || pOldProcess->GetUID() == SProcessUID(ProcessId, Stat.StartTime))
+					break;
+
+				// we missed the exit of the old process
+				m_pProcFiles->Evict(ProcessId);
+				pOldProcess->MarkForRemoval();
+				pOldProcess->UnInit();
+			}
+			if (pOldProcess)
+			{
+				QWriteLocker Locker(&m_ProcessMutex);
+				m_ProcessList.remove(ProcessId);
+				m_bProcessListDirty = true;
+			}
+
+			if (FindProcess(ProcessId, true).isNull())
+			{
+				// Note: the process is already gone, so try at list to fill in what little we know from the event
+				QSharedPointer<CLinuxProcess> pProcess = QSharedPointer<CLinuxProcess>(new CLinuxProcess());
+				pProcess->moveToThread(theAPI->thread());
+				pProcess->InitFromEvent(ProcessId, FindProcess(ParentId, false).data(), TimeStamp);
+				pProcess->MarkForRemoval();
+
+				QWriteLocker Locker(&m_ProcessMutex);
+				if (m_ProcessList.contains(ProcessId))
+					break;
+				m_ProcessList.insert(ProcessId, pProcess);
+				m_bProcessListDirty = true;
+			}
+			m_EventAdded.insert(ProcessId);
+			break;
+		}
+		case CProcConnector::eProcessExec:
+		{
+			QSharedPointer<CLinuxProcess> pProcess = FindProcess(ProcessId, true);
+			if (pProcess.isNull())
+				break;
+
+			// the image and command line have changed, re read the static data
+			char Path[64];
+			QByteArray StatBuffer;
+			sprintf(Path, "/proc/%llu/stat", ProcessId);
+			if (ReadProcFile(Path, StatBuffer) && pProcess->InitStaticData(ProcessId, StatBuffer))
+			{
+				pProcess->MarkDirty(eProcessState);
+				if (!m_EventAdded.contains(ProcessId))
+					m_EventChanged.insert(ProcessId);
+			}
+			break;
+		}
+		case CProcConnector::eProcessExited:
+		{
+			QSharedPointer<CLinuxProcess> pProcess = FindProcess(ProcessId, false);
+			if (pProcess.isNull() || pProcess->IsMarkedForRemoval())
+				break;
+
+			// Note: the actual removal is done in UpdateProcessList once the persistence time is over
+			m_pProcFiles->Evict(ProcessId);
+			pProcess->MarkForRemoval();
+			pProcess->UnInit();
+			pProcess->MarkDirty(eProcessState);
+			m_EventChanged.insert(ProcessId);
+			break;
+		}
+	}
+
+	// Note: we collect the events for a short while, as each update makes the GUI resync the entire list,
+	//			and publishing the process list costs a copy of the whole index, so it is done once per batch as well
+	if (!bFlushPending)
+		QTimer::singleShot(250, this, SLOT(OnProcessEventsFlush()));
+}
+
+void CLinuxAPI::OnProcessEventsLost()
+{
+	// we have missed some events, do a full rescan on the next update
+	m_LastFullRescan = 0;
+}
+
+void CLinuxAPI::OnProcessEventsFlush()
+{
+	QWriteLocker Locker(&m_ProcessMutex);
+	if (m_bProcessListDirty)
+	{
+		PublishProcessList();
+		m_bProcessListDirty = false;
+	}
+	Locker.unlock();
+
+	if (m_EventAdded.isEmpty() && m_EventChanged.isEmpty())
+		return; // UpdateProcessList was faster
+
+	QSet<quint64> Added = m_EventAdded;
+	QSet<quint64> Changed = m_EventChanged;
+	m_EventAdded.clear();
+	m_EventChanged.clear();
+
+	// Note: the events marked the processes dirty, commit this so the views pick up the new names and states right away
+	CommitProcessChanges();
+
+	emit ProcessListUpdated(Added, Changed, QSet<quint64>());
+}
+
 bool CLinuxAPI::UpdateSocketList()
 {
+	if (!m_pSockDiag->Open())
+		return false;
+
+	QVector<SSockDiagEntry> Entries;
+	m_pSockDiag->DumpInet(AF_INET, IPPROTO_TCP, Entries);
+	m_pSockDiag->DumpInet(AF_INET6, IPPROTO_TCP, Entries);
+	m_pSockDiag->DumpInet(AF_INET, IPPROTO_UDP, Entries);
+	m_pSockDiag->DumpInet(AF_INET6, IPPROTO_UDP, Entries);
+	if (theConf->GetBool("Options/LinuxUnixSockets", true))
+		m_pSockDiag->DumpUnix(Entries);
+
+	// Note: the owning process of a new socket is found by its inode in the /proc/<pid>/fd index,
+	//			we only update the index when we see a socket we can not yet assign
+	for (int i = 0; i < Entries.size(); i++)
+	{
+		if (Entries[i].Inode != 0 && !m_SocketByCookie.contains(Entries[i].Cookie) && !m_InodeToPid.contains(Entries[i].Inode))
+		{
+			// Note: a fd number may be reused for a different socket, hence from time to time we re read all links
+			bool bFull = GetCurTick() - m_LastFdFullScan >= theConf->GetUInt64("Options/LinuxFullRescanInterval", 10000);
+			UpdateSocketInodes(bFull);
+			if (bFull)
+				m_LastFdFullScan = GetCurTick();
+			break;
+		}
+	}
+
+	QSet<quint64> Added;
+	QSet<quint64> Changed;
+	QSet<quint64> Removed;
+
+	// Copy the socket map, the kernel socket cookie is our unique identifier
+	QHash<quint64, CSocketPtr> OldSockets = m_SocketByCookie;
+
+	for (int i = 0; i < Entries.size(); i++)
+	{
+		const SSockDiagEntry& Entry = Entries[i];
+		quint64 ProcessId = Entry.Inode != 0 ? m_InodeToPid.value(Entry.Inode, 0) : 0;
+
+		QSharedPointer<CLinuxSocket> pSocket = OldSockets.take(Entry.Cookie).staticCast<CLinuxSocket>();
+		if (!pSocket.isNull() && ProcessId != 0 && pSocket->GetProcessId() != ProcessId)
+		{
+			// the owner was not known when we first saw this socket, re add it with the right one
+			if (CProcessPtr pProcess = pSocket->GetProcess().toStrongRef().staticCast<CProcessInfo>())
+				pProcess->RemoveSocket(pSocket);
+			QWriteLocker Locker(&m_SocketMutex);
+			m_SocketList.remove(pSocket->m_HashID, pSocket);
+			Locker.unlock();
+			Removed.insert(pSocket->m_HashID);
+			pSocket.clear();
+		}
+
+		bool bAdd = false;
+		if (pSocket.isNull())
+		{
+			pSocket = CInfoPool<CLinuxSocket>::New();
+			bAdd = pSocket->InitStaticData(ProcessId, Entry);
+
+			if (ProcessId)
+			{
+				CProcessPtr pProcess = GetProcessByID(ProcessId, true); // Note: this will add the process and load some basic data if it does not already exist
+				if (pProcess)
+				{
+					pSocket->LinkProcess(pProcess);
+					pProcess->AddSocket(pSocket);
+				}
+			}
+
+			m_SocketByCookie.insert(Entry.Cookie, pSocket);
+			QWriteLocker Locker(&m_SocketMutex);
+			m_SocketList.insertMulti(pSocket->m_HashID, pSocket);
+		}
+
+		bool bChanged = pSocket->UpdateDynamicData(Entry);
+
+		if (bAdd)
+			Added.insert(pSocket->m_HashID);
+		else if (bChanged)
+			Changed.insert(pSocket->m_HashID);
+	}
+
+	QWriteLocker Locker(&m_SocketMutex);
+	// purge all sockets left as thay are not longer open
+	for (QHash<quint64, CSocketPtr>::iterator I = OldSockets.begin(); I != OldSockets.end(); ++I)
+	{
+		QSharedPointer<CLinuxSocket> pSocket = I.value().staticCast<CLinuxSocket>();
+		if (pSocket->CanBeRemoved())
+		{
+			if (CProcessPtr pProcess = pSocket->GetProcess().toStrongRef().staticCast<CProcessInfo>())
+				pProcess->RemoveSocket(pSocket);
+			m_SocketList.remove(pSocket->m_HashID, pSocket);
+			m_SocketByCookie.remove(I.key());
+			Removed.insert(pSocket->m_HashID);
+		}
+		else if (!pSocket->IsMarkedForRemoval())
+		{
+			pSocket->SetClosed();
+			pSocket->MarkForRemoval();
+		}
+	}
+	Locker.unlock();
+
+	emit SocketListUpdated(Added, Changed, Removed);
 
 	return true;
 }
 
+void CLinuxAPI::UpdateSocketInodes(bool bFull)
+{
+	QMap<quint64, CProcessPtr> Processes = GetProcessList();
+
+	// drop the index of processes that are gone
+	for (QMap<quint64, SFdIndex>::iterator I = m_FdIndex.begin(); I != m_FdIndex.end(); )
+	{
+		CProcessPtr pProcess = Processes.value(I.key());
+		if (pProcess.isNull() || pProcess->IsMarkedForRemoval())
+		{
+			foreach(quint64 Inode, I.value().Inodes)
+			{
+				QHash<quint64, quint64>::iterator J = m_InodeToPid.find(Inode);
+				if (J != m_InodeToPid.end() && J.value() == I.key())
+					m_InodeToPid.erase(J);
+			}
+			I = m_FdIndex.erase(I);
+		}
+		else
+			++I;
+	}
+
+	char Path[64];
+	char Link[64];
+	QVector<int> Fds;
+	foreach(const CProcessPtr& pProcess, Processes)
+	{
+		if (pProcess->IsMarkedForRemoval())
+			continue;
+
+		quint64 ProcessId = pProcess->GetProcessId();
+		sprintf(Path, "/proc/%llu/fd", ProcessId);
+		DIR* pFdDir = opendir(Path);
+		if (!pFdDir)
+			continue; // the process is gone or we lack the permissions
+
+		Fds.clear();
+		quint64 Signature = 14695981039346656037ULL; // FNV-1a
+		while (struct dirent* pEntry = readdir(pFdDir))
+		{
+			if (pEntry->d_name[0] < '0' || pEntry->d_name[0] > '9')
+				continue;
+			int Fd = atoi(pEntry->d_name);
+			Fds.append(Fd);
+			Signature = (Signature ^ (quint64)Fd) * 1099511628211ULL;
+		}
+		closedir(pFdDir);
+
+		pProcess.staticCast<CLinuxProcess>()->UpdateHandleCount(Fds.size());
+
+		SFdIndex& Index = m_FdIndex[ProcessId];
+		if (!bFull && Index.Signature == Signature)
+			continue; // the fd set did not change
+
+		Index.Signature = Signature;
+		foreach(quint64 Inode, Index.Inodes)
+		{
+			QHash<quint64, quint64>::iterator J = m_InodeToPid.find(Inode);
+			if (J != m_InodeToPid.end() && J.value() == ProcessId)
+				m_InodeToPid.erase(J);
+		}
+		Index.Inodes.clear();
+
+		foreach(int Fd, Fds)
+		{
+			sprintf(Path, "/proc/%llu/fd/%d", ProcessId, Fd);
+			ssize_t Length = readlink(Path, Link, sizeof(Link) - 1);
+			if (Length <= 8 || memcmp(Link, "socket:[", 8) != 0)
+				continue;
+			Link[Length] = 0;
+
+			quint64 Inode = strtoull(Link + 8, NULL, 10);
+			Index.Inodes.append(Inode);
+			m_InodeToPid.insert(Inode, ProcessId);
+		}
+	}
+}
+
 bool CLinuxAPI::UpdateOpenFileList()
 {
 
@@ -63,5 +1125,23 @@ bool CLinuxAPI::UpdateServiceList(bool bRefresh)
 bool CLinuxAPI::UpdateDriverList()
 {
 
-	return true; 
+	return true;
+}
+
+void CLinuxAPI::ClearPersistence()
+{
+	foreach(const CProcessPtr& pProcess, GetProcessList())
+		pProcess->ClearPersistence();
+
+	foreach(const CSocketPtr& pSocket, GetSocketList())
+		pSocket->ClearPersistence();
+
+	foreach(const CHandlePtr& pHandle, GetOpenFilesList())
+		pHandle->ClearPersistence();
+
+	foreach(const CServicePtr& pService, GetServiceList())
+		pService->ClearPersistence();
+
+	foreach(const CDriverPtr& pDriver, GetDriverList())
+		pDriver->ClearPersistence();
 }
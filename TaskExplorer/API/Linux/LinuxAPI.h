@@ -1,6 +1,12 @@
 #pragma once
 #include "../SystemAPI.h"
 
+class CProcConnector;
+class CSockDiag;
+class CProcFileCache;
+class CProcUring;
+class CLinuxProcess;
+
 class CLinuxAPI : public CSystemAPI
 {
 	Q_OBJECT
@@ -25,16 +31,131 @@ public:
 
 	virtual bool UpdateDriverList();
 
+	virtual CProcessPtr GetProcessByID(quint64 ProcessId, bool bAddIfNew = false);
+
+	virtual void MonitorProcConnector(bool bEnable);
+	virtual bool IsMonitoringProcConnector() const	{ return m_pProcConnector != NULL; }
+
     virtual quint64 GetUpTime() const {return 0;}
     virtual QList<SUser> GetUsers() const {return QList<SUser>();}
     virtual QMultiMap<QString, CDnsCacheEntryPtr> GetDnsEntryList() const {return QMultiMap<QString, CDnsCacheEntryPtr>();}
 
+	virtual QString GetUserNameByID(quint32 UserId);
+
+	virtual quint64 GetBootTime() const				{ QReadLocker Locker(&m_Mutex); return m_BootTime; }
+	virtual quint64 GetClockTicks() const			{ return m_ClockTicks; }
+	virtual quint64 GetPageSize() const				{ return m_PageSize; }
+
     virtual bool UpdateDnsCache() {return false;}
     virtual void FlushDnsCache() {}
     virtual void OnHardwareChanged() {}
 
+	virtual void ClearPersistence();
+
+private slots:
+	void		OnProcessEvent(int Type, quint64 ProcessId, quint64 ParentId, quint64 TimeStamp);
+	void		OnProcessEventsLost();
+	void		OnProcessEventsFlush();
+
 protected:
+	quint64 UpdateCpuStats();
+	void UpdateMemoryStats();
+	void UpdateVmStats();
+	void UpdateNetStats();
+	void UpdateSocketInodes(bool bFull);
+
+	// Note: the process events look at the working copy, the processes they add are published with the next flush
+	QSharedPointer<CLinuxProcess> FindProcess(quint64 ProcessId, bool bAddIfNew);
+	QSharedPointer<CLinuxProcess> AddProcess(quint64 ProcessId, bool bPublish);
+
+	bool UseProcUring();
+	enum EBatchState
+	{
+		eBatchNotRead = 0,
+		eBatchRead,
+		eBatchGone
+	};
+	void ReadStatBatch(const QList<quint64>& ProcessIDs, int Start, const QMap<quint64, CProcessPtr>& Processes, QVector<int>& States);
+
+	// one entry per process of an update, the workers fill in the results which are merged once all are done
+	struct SProcessJob
+	{
+		quint64							ProcessId;
+		QSharedPointer<CLinuxProcess>	pProcess; // null for new processes, than set by the worker
+		QSharedPointer<CLinuxProcess>	pOldProcess; // set when the pid was reused by a new process
+		int								BatchState;
+		bool							bRunning;
+		bool							bAdded;
+		bool							bChanged;
+	};
+	struct SUpdateWorker
+	{
+		QByteArray						StatBuffer;
+		QByteArray						ProcBuffer;
+	};
+	struct SUpdateContext
+	{
+		SProcessJob*					pJobs;
+		int								Start;
+		int								End;
+		QAtomicInt						Next; // the next job to be taken by any worker
+		quint64							sysTotalTime;
+		quint32							Demand; // see EProcessDemand
+	};
+	void UpdateProcesses(QVector<SProcessJob>& Jobs, int Start, int Count, quint64 sysTotalTime);
+	void UpdateProcessJobs(SUpdateContext* pContext, SUpdateWorker* pWorker);
+	void UpdateProcess(SProcessJob& Job, int BatchIndex, SUpdateWorker* pWorker, quint64 sysTotalTime, quint32 Demand);
+
+	CProcConnector*			m_pProcConnector;
+	quint64					m_LastFullRescan;
 
+	CProcFileCache*			m_pProcFiles;
+
+	QThreadPool*			m_pUpdatePool;
+	int						m_MaxUpdateWorkers;
+	QVector<SUpdateWorker>	m_UpdateWorkers; // per worker read buffers
+
+	CProcUring*				m_pProcUring;
+	bool					m_bProcUringFailed;
+	QVector<QByteArray>		m_StatBatch;
+
+	CSockDiag*				m_pSockDiag;
+	QHash<quint64, CSocketPtr> m_SocketByCookie;
+
+	// socket inode to process id index, built from /proc/<pid>/fd
+	struct SFdIndex
+	{
+		SFdIndex() : Signature(0) {}
+		quint64				Signature; // hash over the open fd numbers
+		QVector<quint64>	Inodes;
+	};
+	QMap<quint64, SFdIndex>	m_FdIndex;
+	QHash<quint64, quint64>	m_InodeToPid;
+	quint64					m_LastFdFullScan;
+
+	// process events collected since the last flush
+	QSet<quint64>			m_EventAdded;
+	bool					m_bProcessListDirty; // m_ProcessList was changed by events but not yet published
+	QSet<quint64>			m_EventChanged;
+
+	// reused read buffers, to not allocate on every update
+	QByteArray				m_StatBuffer;
+	QByteArray				m_MemInfoBuffer;
+	QByteArray				m_SwapsBuffer;
+	QByteArray				m_VmStatBuffer;
+	QByteArray				m_NetDevBuffer;
+
+	SDelta64				m_CpuIrqDelta;
+
+	quint64					m_BootTime; // seconds since epoch
+	quint64					m_ClockTicks;
+	quint64					m_PageSize;
+
+	mutable QReadWriteLock	m_UserNameMutex;
+	QMap<quint32, QString>	m_UserNames;
 };
 
+// Reads a whole /proc file into Buffer, returns false if the file could not be opened (e.g. process has exited)
+bool ReadProcFile(const char* Path, QByteArray& Buffer);
+
 #define CPU_TIME_DIVIDER (10 * 1000 * 1000) // the clock resolution is 100ns we need 1sec
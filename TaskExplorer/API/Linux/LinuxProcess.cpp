@@ -0,0 +1,560 @@
+#include "stdafx.h"
+#include "LinuxProcess.h"
+#include "LinuxAPI.h"
+#include "ProcParsers.h"
+
+#include <unistd.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+
+#define PF_KTHREAD			0x00200000 // from linux/sched.h
+
+#define IOPRIO_CLASS_SHIFT	13
+#define IOPRIO_WHO_PROCESS	1
+
+CLinuxProcess::CLinuxProcess(QObject *parent) : CProcessInfo(parent)
+{
+	m_SessionId = 0;
+	m_StartTime = 0;
+	m_UserId = -1;
+	m_PeakNumberOfHandles = 0;
+	m_SharedWorkingSetSize = 0;
+	m_CollectedDemand = 0;
+
+	m_State = 0;
+	m_IsKernelThread = false;
+}
+
+CLinuxProcess::~CLinuxProcess()
+{
+}
+
+bool CLinuxProcess::InitStaticData(quint64 ProcessId, const QByteArray& StatBuffer)
+{
+	SProcStat Stat;
+	if (!ParseProcStat(StatBuffer.constData(), StatBuffer.constData() + StatBuffer.size(), Stat))
+		return false;
+
+	return InitStaticData(ProcessId, Stat);
+}
+
+bool CLinuxProcess::InitStaticData(quint64 ProcessId, const SProcStat& Stat)
+{
+	CLinuxAPI* pAPI = (CLinuxAPI*)theAPI;
+
+	QWriteLocker Locker(&m_Mutex);
+
+	m_ProcessId = ProcessId;
+
+	char Path[64];
+	QByteArray Buffer;
+
+	SetStat(Stat, true);
+
+	// Note: the starttime is given in clock ticks since boot
+	m_CreateTimeStamp = pAPI->GetBootTime() * 1000 + m_StartTime * 1000 / pAPI->GetClockTicks();
+
+	sprintf(Path, "/proc/%llu", ProcessId);
+	struct stat FileStat;
+	if (stat(Path, &FileStat) == 0)
+	{
+		m_UserId = FileStat.st_uid;
+		m_UserName = pAPI->GetUserNameByID(m_UserId); // already shared by the user name cache
+	}
+
+	if (!m_IsKernelThread)
+	{
+		sprintf(Path, "/proc/%llu/exe", ProcessId);
+		char FileName[PATH_MAX + 1];
+		ssize_t Len = readlink(Path, FileName, PATH_MAX);
+		if (Len > 0)
+		{
+			FileName[Len] = 0;
+			m_FileName = CStringPool::Intern(QString::fromLocal8Bit(FileName));
+		}
+
+		sprintf(Path, "/proc/%llu/cmdline", ProcessId);
+		if (ReadProcFile(Path, Buffer))
+		{
+			// the arguments are separated by null characters, we want to display them with spaces
+			while (Buffer.endsWith('\0'))
+				Buffer.chop(1);
+			Buffer.replace('\0', ' ');
+			m_CommandLine = CStringPool::Intern(QString::fromLocal8Bit(Buffer));
+		}
+
+		// determine the architecture from the ELF header of the image
+		QFile File(QString("/proc/%1/exe").arg(ProcessId));
+		if (File.open(QFile::ReadOnly))
+		{
+			QByteArray Header = File.read(5);
+			if (Header.size() == 5 && Header.startsWith("\x7f" "ELF"))
+				m_ArchString = Header.at(4) == 2 ? tr("x64") : tr("x86");
+		}
+	}
+
+	// Note: for kernel threads we only have the name from the stat file
+	if (!m_FileName.isEmpty())
+		m_ProcessName = CStringPool::Intern(m_FileName.mid(m_FileName.lastIndexOf("/") + 1));
+
+	cpu_set_t CpuSet;
+	CPU_ZERO(&CpuSet);
+	if (sched_getaffinity(ProcessId, sizeof(CpuSet), &CpuSet) == 0)
+	{
+		m_AffinityMask = 0;
+		for (int i = 0; i < 64 && i < CPU_SETSIZE; i++)
+		{
+			if (CPU_ISSET(i, &CpuSet))
+				m_AffinityMask |= (1ULL << i);
+		}
+	}
+
+	InitPresets();
+
+	return true;
+}
+
+void CLinuxProcess::InitFromEvent(quint64 ProcessId, CProcessInfo* pParent, quint64 TimeStamp)
+{
+	CLinuxAPI* pAPI = (CLinuxAPI*)theAPI;
+
+	QWriteLocker Locker(&m_Mutex);
+
+	m_ProcessId = ProcessId;
+
+	// Note: the TimeStamp is in ns since boot, the start time in clock ticks since boot
+	m_StartTime = TimeStamp * pAPI->GetClockTicks() / (1000 * 1000 * 1000);
+	m_CreateTimeStamp = pAPI->GetBootTime() * 1000 + TimeStamp / (1000 * 1000);
+
+	// a forked process inherits everything from its parent until it execs
+	if (pParent)
+	{
+		m_ParentProcessId = pParent->GetProcessId();
+		m_ProcessName = pParent->GetName();
+		m_FileName = pParent->GetFileName();
+		m_UserName = pParent->GetUserName();
+	}
+	else
+		m_ProcessName = tr("Unknown process PID: %1").arg(ProcessId);
+}
+
+void CLinuxProcess::SetStat(const SProcStat& Stat, bool bInit)
+{
+	if (bInit)
+	{
+		m_ProcessName = CStringPool::Intern(QString::fromLocal8Bit(Stat.pName, Stat.NameLength));
+		m_ParentProcessId = Stat.ParentId;
+		m_SessionId = Stat.SessionId;
+		m_IsKernelThread = (Stat.Flags & PF_KTHREAD) != 0;
+		m_StartTime = Stat.StartTime;
+		return;
+	}
+
+	CLinuxAPI* pAPI = (CLinuxAPI*)theAPI;
+
+	m_State = Stat.State;
+
+	long Priority = Stat.Nice;
+	long BasePriority = Stat.Priority;
+	if (m_Priority != Priority || m_BasePriority != BasePriority)
+	{
+		m_Priority = Priority;
+		m_BasePriority = BasePriority;
+
+		if (!m_PersistentPreset.isNull())
+			QTimer::singleShot(0, this, SLOT(ApplyPresets()));
+	}
+
+	// Note: CPU times are given in clock ticks, we use 100ns units like on windows
+	m_UserTime = Stat.UserTime * CPU_TIME_DIVIDER / pAPI->GetClockTicks();
+	m_KernelTime = Stat.KernelTime * CPU_TIME_DIVIDER / pAPI->GetClockTicks();
+
+	m_NumberOfThreads = Stat.NumThreads;
+	if (m_NumberOfThreads > m_PeakNumberOfThreads)
+		m_PeakNumberOfThreads = m_NumberOfThreads;
+
+	m_VirtualSize = Stat.VirtualSize;
+	if (m_VirtualSize > m_PeakVirtualSize)
+		m_PeakVirtualSize = m_VirtualSize;
+
+	m_WorkingSetSize = Stat.ResidentPages * pAPI->GetPageSize();
+	if (m_WorkingSetSize > m_PeakWorkingSetSize)
+		m_PeakWorkingSetSize = m_WorkingSetSize;
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	m_CpuStats.PageFaultsDelta.Update64(Stat.MinorFaults + Stat.MajorFaults);
+	m_CpuStats.HardFaultsDelta.Update64(Stat.MajorFaults);
+}
+
+void CLinuxProcess::SetStatm(const SProcStatm& Statm)
+{
+	CLinuxAPI* pAPI = (CLinuxAPI*)theAPI;
+
+	m_SharedWorkingSetSize = Statm.Shared * pAPI->GetPageSize();
+	m_WorkingSetPrivateSize = (Statm.Resident > Statm.Shared ? Statm.Resident - Statm.Shared : 0) * pAPI->GetPageSize();
+
+	quint64 PrivateBytes = Statm.Data * pAPI->GetPageSize();
+	if (PrivateBytes > m_PeakPagefileUsage)
+		m_PeakPagefileUsage = PrivateBytes;
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+	m_CpuStats.PrivateBytesDelta.Update(PrivateBytes);
+}
+
+void CLinuxProcess::SetIo(const SProcIo& Io)
+{
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	// rchar/wchar count all I/O done through read and write like calls, read_bytes/write_bytes only what hit the storage
+	m_Stats.Io.SetRead(Io.ReadChars, Io.ReadCalls);
+	m_Stats.Io.SetWrite(Io.WriteChars, Io.WriteCalls);
+	m_Stats.Disk.SetRead(Io.ReadBytes, 0);
+	m_Stats.Disk.SetWrite(Io.WriteBytes, 0);
+}
+
+void CLinuxProcess::SetStatus(const SProcStatus& Status)
+{
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	m_CpuStats.ContextSwitchesDelta.Update64(Status.VoluntaryCtxtSwitches + Status.NonVoluntaryCtxtSwitches);
+}
+
+bool CLinuxProcess::UpdateDynamicData(const SProcStat& Stat, CProcFileCache* pProcFiles, QByteArray& Buffer, quint64 sysTotalTime, quint32 Demand)
+{
+	// Note: the files are read and parsed before we lock the process, so the getters never wait for the procfs I/O
+	quint64 ProcessId = GetProcessId();
+	quint64 StartTime = GetRawCreateTime();
+
+	SProcStatm Statm;
+	bool bStatm = pProcFiles->Read(ProcessId, StartTime, CProcFileCache::eStatm, Buffer)
+		&& ParseProcStatm(Buffer.constData(), Buffer.constData() + Buffer.size(), Statm);
+
+	SProcIo Io;
+	bool bIo = (Demand & eDemandIo) != 0 && pProcFiles->Read(ProcessId, StartTime, CProcFileCache::eIo, Buffer)
+		&& ParseProcIo(Buffer.constData(), Buffer.constData() + Buffer.size(), Io);
+
+	SProcStatus Status;
+	bool bStatus = (Demand & eDemandSwitches) != 0 && pProcFiles->Read(ProcessId, StartTime, CProcFileCache::eStatus, Buffer)
+		&& ParseProcStatus(Buffer.constData(), Buffer.constData() + Buffer.size(), Status);
+
+	int NumberOfHandles = (Demand & eDemandHandles) != 0 ? CountFds(ProcessId) : -1;
+
+	QWriteLocker Locker(&m_Mutex);
+
+	char OldState = m_State;
+	long OldPriority = m_Priority;
+
+	SetStat(Stat, false);
+
+	if (bStatm)
+		SetStatm(Statm);
+
+	// Note: when a value was not gathered for a while, its next delta would contain everything since then, hence we start over
+	quint32 Resumed = Demand & ~m_CollectedDemand;
+	m_CollectedDemand = Demand;
+	if (Resumed)
+	{
+		QWriteLocker StatsLocker(&m_StatsMutex);
+		if (Resumed & eDemandIo)
+		{
+			m_Stats.Io = SIOStatsEx();
+			m_Stats.Disk = SIOStats();
+		}
+		if (Resumed & eDemandSwitches)
+			m_CpuStats.ContextSwitchesDelta = SDelta32_64();
+	}
+
+	if (bIo)
+		SetIo(Io);
+
+	if (bStatus)
+		SetStatus(Status);
+
+	if (NumberOfHandles != -1)
+		SetHandleCount(NumberOfHandles);
+
+	bool modified = (OldState != m_State) || (OldPriority != m_Priority);
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	// Update the deltas.
+	m_CpuStats.CpuKernelDelta.Update(m_KernelTime);
+	m_CpuStats.CpuUserDelta.Update(m_UserTime);
+
+	m_CpuStats.UpdateStats(sysTotalTime);
+
+	m_Stats.UpdateStats();
+
+	PublishStats();
+
+	return modified;
+}
+
+int CLinuxProcess::CountFds(quint64 ProcessId)
+{
+	char Path[64];
+	sprintf(Path, "/proc/%llu/fd", ProcessId);
+	DIR* pFdDir = opendir(Path);
+	if (!pFdDir)
+		return -1; // the process is gone or we lack the permissions
+
+	int Count = 0;
+	while (struct dirent* pEntry = readdir(pFdDir))
+	{
+		if (pEntry->d_name[0] >= '0' && pEntry->d_name[0] <= '9')
+			Count++;
+	}
+	closedir(pFdDir);
+	return Count;
+}
+
+void CLinuxProcess::UpdateHandleCount(quint32 NumberOfHandles)
+{
+	QWriteLocker Locker(&m_Mutex);
+	SetHandleCount(NumberOfHandles);
+}
+
+void CLinuxProcess::SetHandleCount(quint32 NumberOfHandles)
+{
+	// Note: on linux the open file descriptors are the closest thing to handles
+	m_NumberOfHandles = NumberOfHandles;
+	if (m_PeakNumberOfHandles < NumberOfHandles)
+		m_PeakNumberOfHandles = NumberOfHandles;
+}
+
+void CLinuxProcess::UnInit()
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	QWriteLocker StatsLocker(&m_StatsMutex);
+
+	// Update the deltas.
+	m_CpuStats.CpuKernelDelta.Delta = 0;
+	m_CpuStats.CpuUserDelta.Delta = 0;
+	m_CpuStats.CycleDelta.Delta = 0;
+
+	m_CpuStats.ContextSwitchesDelta.Delta = 0;
+	m_CpuStats.PageFaultsDelta.Delta = 0;
+	m_CpuStats.HardFaultsDelta.Delta = 0;
+	m_CpuStats.PrivateBytesDelta.Delta = 0;
+
+	m_CpuStats.CpuUsage = 0;
+	m_CpuStats.CpuKernelUsage = 0;
+	m_CpuStats.CpuUserUsage = 0;
+
+	m_Stats.Net.ReceiveDelta.Delta = 0;
+	m_Stats.Net.SendDelta.Delta = 0;
+	m_Stats.Net.ReceiveRawDelta.Delta = 0;
+	m_Stats.Net.SendRawDelta.Delta = 0;
+	m_Stats.Net.ReceiveRate.Clear();
+	m_Stats.Net.SendRate.Clear();
+
+	m_Stats.Io.ReadDelta.Delta = 0;
+	m_Stats.Io.WriteDelta.Delta = 0;
+	m_Stats.Io.OtherDelta.Delta = 0;
+	m_Stats.Io.ReadRawDelta.Delta = 0;
+	m_Stats.Io.WriteRawDelta.Delta = 0;
+	m_Stats.Io.OtherRawDelta.Delta = 0;
+	m_Stats.Io.ReadRate.Clear();
+	m_Stats.Io.WriteRate.Clear();
+	m_Stats.Io.OtherRate.Clear();
+
+	m_Stats.Disk.ReadDelta.Delta = 0;
+	m_Stats.Disk.WriteDelta.Delta = 0;
+	m_Stats.Disk.ReadRawDelta.Delta = 0;
+	m_Stats.Disk.WriteRawDelta.Delta = 0;
+	m_Stats.Disk.ReadRate.Clear();
+	m_Stats.Disk.WriteRate.Clear();
+
+	PublishStats();
+}
+
+bool CLinuxProcess::ValidateParent(CProcessInfo* pParent) const
+{
+	QReadLocker Locker(&m_Mutex);
+
+	if (!pParent || pParent->GetProcessId() == m_ProcessId)
+        return false;
+
+	// We make sure that the process item we found is actually the parent process - its start time
+	// must not be larger than the supplied time.
+	quint64 uParentStartTime = qobject_cast<CLinuxProcess*>(pParent)->GetRawCreateTime();
+	return uParentStartTime <= m_StartTime;
+}
+
+QString CLinuxProcess::GetWorkingDirectory() const
+{
+	char Path[64];
+	sprintf(Path, "/proc/%llu/cwd", GetProcessId());
+	char WorkingDir[PATH_MAX + 1];
+	ssize_t Len = readlink(Path, WorkingDir, PATH_MAX);
+	if (Len <= 0)
+		return QString();
+	WorkingDir[Len] = 0;
+	return QString::fromLocal8Bit(WorkingDir);
+}
+
+QString CLinuxProcess::GetIOPriorityString() const
+{
+	long Value = GetIOPriority();
+	switch (Value >> IOPRIO_CLASS_SHIFT)
+	{
+	case 1:	return tr("Real time %1").arg(Value & ((1 << IOPRIO_CLASS_SHIFT) - 1));
+	case 2:	return tr("Best effort %1").arg(Value & ((1 << IOPRIO_CLASS_SHIFT) - 1));
+	case 3:	return tr("Idle");
+	default:return tr("None");
+	}
+}
+
+STATUS CLinuxProcess::SetPriority(long Value)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	if (setpriority(PRIO_PROCESS, m_ProcessId, Value) != 0)
+		return ERR(tr("Failed to set process priority"), errno);
+
+	m_Priority = Value;
+	return OK;
+}
+
+STATUS CLinuxProcess::SetIOPriority(long Value)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, (int)m_ProcessId, (int)Value) != 0)
+		return ERR(tr("Failed to set process I/O priority"), errno);
+
+	m_IOPriority = Value;
+	return OK;
+}
+
+STATUS CLinuxProcess::SetAffinityMask(quint64 Value)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	cpu_set_t CpuSet;
+	CPU_ZERO(&CpuSet);
+	for (int i = 0; i < 64 && i < CPU_SETSIZE; i++)
+	{
+		if (Value & (1ULL << i))
+			CPU_SET(i, &CpuSet);
+	}
+
+	if (sched_setaffinity(m_ProcessId, sizeof(CpuSet), &CpuSet) != 0)
+		return ERR(tr("Failed to set CPU affinity"), errno);
+
+	m_AffinityMask = Value;
+	return OK;
+}
+
+STATUS CLinuxProcess::Terminate(bool bForce)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	if (!bForce && m_ProcessId == 1)
+		return ERR(tr("You are about to terminate the init process. This will shut down the operating system immediately."), ERROR_CONFIRM);
+
+	if (kill(m_ProcessId, bForce ? SIGKILL : SIGTERM) != 0)
+		return ERR(tr("Failed to terminate process"), errno);
+	return OK;
+}
+
+STATUS CLinuxProcess::Suspend()
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	if (kill(m_ProcessId, SIGSTOP) != 0)
+		return ERR(tr("Failed to suspend process"), errno);
+	return OK;
+}
+
+STATUS CLinuxProcess::Resume()
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	if (kill(m_ProcessId, SIGCONT) != 0)
+		return ERR(tr("Failed to resume process"), errno);
+	return OK;
+}
+
+QString CLinuxProcess::GetStatusString() const
+{
+	QStringList Status;
+
+	if(m_RemoveTimeStamp != 0)
+		Status.append(tr("Terminated"));
+
+	QReadLocker Locker(&m_Mutex);
+
+	switch (m_State)
+	{
+	case 'R':	Status.append(tr("Running")); break;
+	case 'D':	Status.append(tr("Disk sleep")); break;
+	case 'Z':	Status.append(tr("Zombie")); break;
+	case 'T':	Status.append(tr("Suspended")); break;
+	case 't':	Status.append(tr("Debugged")); break;
+	case 'X':	Status.append(tr("Dead")); break;
+	case 'I':	Status.append(tr("Idle")); break;
+	}
+
+	if (m_IsKernelThread)
+		Status.append(tr("Kernel thread"));
+
+	return Status.join(", ");
+}
+
+bool CLinuxProcess::IsSystemProcess() const
+{
+	QReadLocker Locker(&m_Mutex);
+	return m_IsKernelThread || m_ProcessId == 1;
+}
+
+bool CLinuxProcess::IsServiceProcess() const
+{
+	QReadLocker Locker(&m_Mutex);
+	// daemons are usually started by init and run under a system account
+	return !m_IsKernelThread && m_ParentProcessId == 1 && m_UserId < 1000;
+}
+
+bool CLinuxProcess::IsUserProcess() const
+{
+	QReadLocker Locker(&m_Mutex);
+	return m_UserId == getuid();
+}
+
+bool CLinuxProcess::IsElevated() const
+{
+	QReadLocker Locker(&m_Mutex);
+	// Note: a process running as root which is neither part of the system nor a daemon was started elevated
+	return m_UserId == 0 && !m_IsKernelThread && m_ProcessId != 1 && m_ParentProcessId != 1;
+}
+
+QMap<QString, CProcessInfo::SEnvVar> CLinuxProcess::GetEnvVariables() const
+{
+	QMap<QString, SEnvVar> EnvVars;
+
+	char Path[64];
+	sprintf(Path, "/proc/%llu/environ", GetProcessId());
+	QByteArray Buffer;
+	if (!ReadProcFile(Path, Buffer))
+		return EnvVars;
+
+	foreach(const QByteArray& Entry, Buffer.split('\0'))
+	{
+		int pos = Entry.indexOf('=');
+		if (pos <= 0)
+			continue;
+
+		SEnvVar EnvVar;
+		EnvVar.Name = QString::fromLocal8Bit(Entry.left(pos));
+		EnvVar.Value = QString::fromLocal8Bit(Entry.mid(pos + 1));
+		EnvVars.insert(EnvVar.GetTypeName(), EnvVar);
+	}
+
+	return EnvVars;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "../ProcessInfo.h"
+#include "ProcFileCache.h"
+
+struct SProcStat;
+struct SProcStatm;
+struct SProcIo;
+struct SProcStatus;
+
+
+class CLinuxProcess : public CProcessInfo
+{
+	Q_OBJECT
+
+public:
+	CLinuxProcess(QObject *parent = nullptr);
+	virtual ~CLinuxProcess();
+
+	virtual bool ValidateParent(CProcessInfo* pParent) const;
+
+	// Basic
+	virtual QString GetArchString() const				{ QReadLocker Locker(&m_Mutex); return m_ArchString; }
+	virtual quint64 GetSessionID() const				{ QReadLocker Locker(&m_Mutex); return m_SessionId; }
+	virtual quint16 GetSubsystem() const				{ return 0; }
+	virtual QString GetSubsystemString() const			{ return tr("Linux"); }
+	virtual quint64 GetRawCreateTime() const			{ QReadLocker Locker(&m_Mutex); return m_StartTime; } // in clock ticks since boot
+	virtual QString GetWorkingDirectory() const;
+
+	virtual quint32 GetUserId() const					{ QReadLocker Locker(&m_Mutex); return m_UserId; }
+
+	// Dynamic
+	virtual quint32	GetPeakNumberOfHandles() const		{ QReadLocker Locker(&m_Mutex); return m_PeakNumberOfHandles; }
+	virtual quint64 GetSharedWorkingSetSize() const		{ QReadLocker Locker(&m_Mutex); return m_SharedWorkingSetSize; }
+	virtual quint64 GetShareableWorkingSetSize() const	{ QReadLocker Locker(&m_Mutex); return m_SharedWorkingSetSize; }
+	virtual quint64 GetMinimumWS() const				{ return 0; }
+	virtual quint64 GetMaximumWS() const				{ return 0; }
+
+	virtual QString GetPriorityString() const			{ return QString::number(GetPriority()); } // nice value
+	virtual QString GetBasePriorityString() const		{ return QString::number(GetBasePriority()); }
+	virtual QString GetPagePriorityString() const		{ return QString(); }
+	virtual QString GetIOPriorityString() const;
+	virtual STATUS SetPriority(long Value);
+	virtual STATUS SetBasePriority(long Value)			{ return ERR(); }
+	virtual STATUS SetPagePriority(long Value)			{ return ERR(); }
+	virtual STATUS SetIOPriority(long Value);
+
+	virtual STATUS SetAffinityMask(quint64 Value);
+
+	virtual STATUS Terminate(bool bForce);
+
+	virtual bool IsSuspended() const					{ QReadLocker Locker(&m_Mutex); return m_State == 'T'; }
+	virtual STATUS Suspend();
+	virtual STATUS Resume();
+
+	virtual QString GetStatusString() const;
+
+	virtual bool HasDebugger() const					{ QReadLocker Locker(&m_Mutex); return m_State == 't'; }
+	virtual STATUS AttachDebugger()						{ return ERR(); }
+	virtual STATUS DetachDebugger()						{ return ERR(); }
+
+	virtual bool IsKernelThread() const					{ QReadLocker Locker(&m_Mutex); return m_IsKernelThread; }
+	virtual bool IsSystemProcess() const;
+	virtual bool IsServiceProcess() const;
+	virtual bool IsUserProcess() const;
+	virtual bool IsElevated() const;
+
+	virtual QMap<QString, SEnvVar>	GetEnvVariables() const;
+	virtual STATUS					DeleteEnvVariable(const QString& Name)						{ return ERR(); }
+	virtual STATUS					EditEnvVariable(const QString& Name, const QString& Value)	{ return ERR(); }
+
+	virtual QMap<quint64, CMemoryPtr> GetMemoryMap() const	{ return QMap<quint64, CMemoryPtr>(); }
+
+	virtual QList<CWndPtr> GetWindows() const			{ return QList<CWndPtr>(); }
+	virtual CWndPtr	GetMainWindow() const				{ return CWndPtr(); }
+
+	virtual STATUS LoadModule(const QString& Path)		{ return ERR(); }
+
+public slots:
+	virtual bool	UpdateThreads()						{ return false; }
+	virtual bool	UpdateHandles()						{ return false; }
+	virtual bool	UpdateModules()						{ return false; }
+	virtual bool	UpdateWindows()						{ return false; }
+
+protected:
+	friend class CLinuxAPI;
+
+	bool InitStaticData(quint64 ProcessId, const QByteArray& StatBuffer);
+	bool InitStaticData(quint64 ProcessId, const SProcStat& Stat);
+	void InitFromEvent(quint64 ProcessId, CProcessInfo* pParent, quint64 TimeStamp);
+	bool UpdateDynamicData(const SProcStat& Stat, CProcFileCache* pProcFiles, QByteArray& Buffer, quint64 sysTotalTime, quint32 Demand);
+	void UnInit();
+	void UpdateHandleCount(quint32 NumberOfHandles);
+	static int CountFds(quint64 ProcessId); // -1 if the fd directory can not be listed
+
+	// *NOT Thread Safe* internal functions
+	void SetStat(const SProcStat& Stat, bool bInit);
+	void SetStatm(const SProcStatm& Statm);
+	void SetIo(const SProcIo& Io);
+	void SetStatus(const SProcStatus& Status);
+	void SetHandleCount(quint32 NumberOfHandles);
+
+	quint64							m_SessionId;
+	quint64							m_StartTime;
+	QString							m_ArchString;
+	quint32							m_UserId;
+	quint32							m_PeakNumberOfHandles;
+	quint64							m_SharedWorkingSetSize;
+	quint32							m_CollectedDemand; // the optional values gathered in the last update, see EProcessDemand
+
+	char							m_State;
+	bool							m_IsKernelThread;
+};
+
@@ -0,0 +1,143 @@
+#include "stdafx.h"
+#include "LinuxSocket.h"
+#include "LinuxAPI.h"
+#include "../ProcessInfo.h"
+
+#include <errno.h>
+
+#define MIB_TCP_STATE_LISTEN	2 // see SocketInfo.cpp
+
+CLinuxSocket::CLinuxSocket()
+{
+	m_Inode = 0;
+	m_Cookie = 0;
+	m_Interface = 0;
+	m_UserId = -1;
+
+	m_HasTcpInfo = false;
+	m_RoundTripTime = 0;
+	m_RoundTripTimeVar = 0;
+	m_Retransmissions = 0;
+	m_CongestionWindow = 0;
+}
+
+CLinuxSocket::~CLinuxSocket()
+{
+}
+
+bool CLinuxSocket::InitStaticData(quint64 ProcessId, const SSockDiagEntry& Entry)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	// Note: sock_diag does not tell us when the socket was created
+	m_CreateTimeStamp = GetTime() * 1000;
+
+	m_ProtocolType = Entry.ProtocolType;
+	m_LocalAddress = Entry.LocalAddress;
+	m_LocalPort = Entry.LocalPort;
+	m_RemoteAddress = Entry.RemoteAddress;
+	m_RemotePort = Entry.RemotePort;
+	m_ProcessId = ProcessId;
+
+	m_Inode = Entry.Inode;
+	m_Cookie = Entry.Cookie;
+	m_Interface = Entry.Interface;
+	m_UserId = Entry.UserId;
+	m_Path = Entry.Path;
+
+	// Note: sockets in TIME_WAIT and alike have no inode, they are not owned by any process anymore
+	if (m_Inode == 0)
+		m_ProcessName = CStringPool::Intern(tr("Waiting connections"));
+	else if (m_ProcessId == 0)
+		m_ProcessName = CStringPool::Intern(tr("Unknown process"));
+	else
+		m_ProcessName = tr("Unknown process PID: %1").arg(m_ProcessId);
+
+	// generate a somewhat unique id to optimize map search
+	m_HashID = CSocketInfo::MkHash(ProcessId, m_ProtocolType, m_LocalAddress, m_LocalPort, m_RemoteAddress, m_RemotePort);
+
+	return true;
+}
+
+void CLinuxSocket::LinkProcess(QSharedPointer<QObject> pProcess)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	m_ProcessName = pProcess.staticCast<CProcessInfo>()->GetName();
+	m_pProcess = pProcess; // relember m_pProcess is a week pointer
+
+	ProcessSetNetworkFlag();
+}
+
+bool CLinuxSocket::UpdateDynamicData(const SSockDiagEntry& Entry)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	bool modified = false;
+
+	if (m_State != Entry.State)
+	{
+		m_State = Entry.State;
+		modified = true;
+
+		if (m_State == MIB_TCP_STATE_LISTEN)
+			ProcessSetNetworkFlag();
+	}
+
+	if (Entry.HasTcpInfo)
+	{
+		m_HasTcpInfo = true;
+		m_RoundTripTime = Entry.RoundTripTime;
+		m_RoundTripTimeVar = Entry.RoundTripTimeVar;
+		m_Retransmissions = Entry.Retransmissions;
+		m_CongestionWindow = Entry.CongestionWindow;
+
+		// Note: the kernel keeps running totals, UpdateStats turns them into deltas and rates
+		QWriteLocker StatsLocker(&m_StatsMutex);
+		m_Stats.Net.SetSend(Entry.BytesSent, Entry.SegmentsSent);
+		m_Stats.Net.SetReceive(Entry.BytesReceived, Entry.SegmentsReceived);
+	}
+
+	UpdateStats();
+
+	return modified;
+}
+
+void CLinuxSocket::ProcessSetNetworkFlag()
+{
+	// when calling this QWriteLocker Locker(&m_Mutex); must be locked!
+
+	CProcessPtr pProcess = m_pProcess.toStrongRef().staticCast<CProcessInfo>();
+	if (!pProcess)
+		return;
+
+	if (m_State == MIB_TCP_STATE_LISTEN) // TCP server
+		pProcess->SetNetworkUsageFlag(NET_TYPE_PROTOCOL_TCP_SRV);
+
+	pProcess->SetNetworkUsageFlag(m_ProtocolType & NET_TYPE_PROTOCOL_MASK);
+}
+
+STATUS CLinuxSocket::Close()
+{
+	QReadLocker Locker(&m_Mutex);
+
+	if ((m_ProtocolType & NET_TYPE_PROTOCOL_TCP) == 0)
+		return ERR(tr("Not supported type or state"));
+
+	SSockDiagEntry Entry;
+	Entry.ProtocolType = m_ProtocolType;
+	Entry.LocalAddress = m_LocalAddress;
+	Entry.LocalPort = m_LocalPort;
+	Entry.RemoteAddress = m_RemoteAddress;
+	Entry.RemotePort = m_RemotePort;
+	Entry.Interface = m_Interface;
+	Entry.Cookie = m_Cookie;
+	Locker.unlock();
+
+	// Note: SOCK_DESTROY requires CAP_NET_ADMIN and a kernel built with CONFIG_INET_DIAG_DESTROY
+	CSockDiag SockDiag;
+	if (!SockDiag.Open() || !SockDiag.Destroy(Entry))
+		return ERR(tr("Failed to close socket"), errno);
+
+	return OK;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "../SocketInfo.h"
+#include "SockDiag.h"
+
+class CLinuxSocket : public CSocketInfo
+{
+	Q_DECLARE_TR_FUNCTIONS(CLinuxSocket)
+public:
+	CLinuxSocket();
+	virtual ~CLinuxSocket();
+
+	virtual quint64			GetInode() const		{ QReadLocker Locker(&m_Mutex); return m_Inode; }
+	virtual quint64			GetCookie() const		{ QReadLocker Locker(&m_Mutex); return m_Cookie; }
+	virtual quint32			GetUserId() const		{ QReadLocker Locker(&m_Mutex); return m_UserId; }
+	virtual QString			GetPath() const			{ QReadLocker Locker(&m_Mutex); return m_Path; }
+
+	virtual bool			HasTcpInfo() const				{ QReadLocker Locker(&m_Mutex); return m_HasTcpInfo; }
+	virtual quint32			GetRoundTripTime() const		{ QReadLocker Locker(&m_Mutex); return m_RoundTripTime; } // in us
+	virtual quint32			GetRoundTripTimeVar() const		{ QReadLocker Locker(&m_Mutex); return m_RoundTripTimeVar; } // in us
+	virtual quint32			GetRetransmissions() const		{ QReadLocker Locker(&m_Mutex); return m_Retransmissions; }
+	virtual quint32			GetCongestionWindow() const		{ QReadLocker Locker(&m_Mutex); return m_CongestionWindow; }
+
+	virtual STATUS			Close();
+
+protected:
+	friend class CLinuxAPI;
+
+	bool InitStaticData(quint64 ProcessId, const SSockDiagEntry& Entry);
+
+	void LinkProcess(QSharedPointer<QObject> pProcess);
+
+	bool UpdateDynamicData(const SSockDiagEntry& Entry);
+
+	void			ProcessSetNetworkFlag();
+
+	quint64			m_Inode;
+	quint64			m_Cookie;
+	quint32			m_Interface;
+	quint32			m_UserId;
+	QString			m_Path; // UNIX sockets only
+
+	bool			m_HasTcpInfo;
+	quint32			m_RoundTripTime;
+	quint32			m_RoundTripTimeVar;
+	quint32			m_Retransmissions;
+	quint32			m_CongestionWindow;
+};
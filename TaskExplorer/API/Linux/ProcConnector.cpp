@@ -0,0 +1,125 @@
+#include "stdafx.h"
+#include "ProcConnector.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+
+CProcConnector::CProcConnector(QObject *parent) : QThread(parent)
+{
+	m_bRunning = false;
+	m_Socket = -1;
+}
+
+CProcConnector::~CProcConnector()
+{
+	m_bRunning = false;
+	wait();
+
+	if (m_Socket != -1)
+	{
+		Subscribe(false);
+		close(m_Socket);
+	}
+}
+
+bool CProcConnector::Init()
+{
+	// Note: subscribing to the proc connector requires CAP_NET_ADMIN
+	m_Socket = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+	if (m_Socket == -1)
+		return false;
+
+	struct sockaddr_nl Address;
+	memset(&Address, 0, sizeof(Address));
+	Address.nl_family = AF_NETLINK;
+	Address.nl_groups = CN_IDX_PROC;
+	Address.nl_pid = 0; // let the kernel assign a unique id
+
+	if (bind(m_Socket, (struct sockaddr*)&Address, sizeof(Address)) == -1 || !Subscribe(true))
+	{
+		close(m_Socket);
+		m_Socket = -1;
+		return false;
+	}
+
+	m_bRunning = true;
+	start();
+	return true;
+}
+
+bool CProcConnector::Subscribe(bool bListen)
+{
+	char Buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+	memset(Buffer, 0, sizeof(Buffer));
+
+	struct nlmsghdr* pHeader = (struct nlmsghdr*)Buffer;
+	pHeader->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+	pHeader->nlmsg_type = NLMSG_DONE;
+	pHeader->nlmsg_pid = 0;
+
+	struct cn_msg* pMessage = (struct cn_msg*)NLMSG_DATA(pHeader);
+	pMessage->id.idx = CN_IDX_PROC;
+	pMessage->id.val = CN_VAL_PROC;
+	pMessage->len = sizeof(enum proc_cn_mcast_op);
+	*(enum proc_cn_mcast_op*)pMessage->data = bListen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+
+	return send(m_Socket, pHeader, pHeader->nlmsg_len, 0) != -1;
+}
+
+void CProcConnector::run()
+{
+	char Buffer[8192] __attribute__((aligned(NLMSG_ALIGNTO)));
+
+	while (m_bRunning)
+	{
+		// Note: we poll with a timeout so that we can quit in a timely manner
+		struct pollfd Poll;
+		Poll.fd = m_Socket;
+		Poll.events = POLLIN;
+		if (poll(&Poll, 1, 250) <= 0)
+			continue;
+
+		ssize_t Length = recv(m_Socket, Buffer, sizeof(Buffer), 0);
+		if (Length <= 0)
+		{
+			// ENOBUFS means the kernel dropped events as we did not keep up, the caller must do a full rescan
+			if (Length == -1 && errno == ENOBUFS)
+				emit EventsLost();
+			continue;
+		}
+
+		for (struct nlmsghdr* pHeader = (struct nlmsghdr*)Buffer; NLMSG_OK(pHeader, Length); pHeader = NLMSG_NEXT(pHeader, Length))
+		{
+			if (pHeader->nlmsg_type == NLMSG_ERROR || pHeader->nlmsg_type == NLMSG_NOOP)
+				continue;
+
+			struct cn_msg* pMessage = (struct cn_msg*)NLMSG_DATA(pHeader);
+			if (pMessage->id.idx != CN_IDX_PROC || pMessage->id.val != CN_VAL_PROC)
+				continue;
+
+			struct proc_event* pEvent = (struct proc_event*)pMessage->data;
+			switch (pEvent->what)
+			{
+			case proc_event::PROC_EVENT_FORK:
+				// Note: new threads are reported as forks too, we only care about new processes
+				if (pEvent->event_data.fork.child_pid == pEvent->event_data.fork.child_tgid)
+					emit ProcessEvent(eProcessForked, pEvent->event_data.fork.child_tgid, pEvent->event_data.fork.parent_tgid, pEvent->timestamp_ns);
+				break;
+			case proc_event::PROC_EVENT_EXEC:
+				emit ProcessEvent(eProcessExec, pEvent->event_data.exec.process_tgid, 0, pEvent->timestamp_ns);
+				break;
+			case proc_event::PROC_EVENT_EXIT:
+				if (pEvent->event_data.exit.process_pid == pEvent->event_data.exit.process_tgid)
+					emit ProcessEvent(eProcessExited, pEvent->event_data.exit.process_tgid, 0, pEvent->timestamp_ns);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
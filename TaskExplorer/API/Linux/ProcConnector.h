@@ -0,0 +1,34 @@
+#pragma once
+
+class CProcConnector : public QThread
+{
+    Q_OBJECT
+
+public:
+	CProcConnector(QObject *parent = nullptr);
+    virtual ~CProcConnector();
+
+	bool		Init();
+
+	bool		IsRunning() { return m_bRunning; }
+
+	enum EEventType
+	{
+		eProcessForked = 0,
+		eProcessExec,
+		eProcessExited
+	};
+
+signals:
+	// Note: TimeStamp is in ns since boot
+	void		ProcessEvent(int Type, quint64 ProcessId, quint64 ParentId, quint64 TimeStamp);
+	void		EventsLost();
+
+protected:
+	virtual void run();
+
+	bool		Subscribe(bool bListen);
+
+	volatile bool m_bRunning;
+	int			m_Socket;
+};
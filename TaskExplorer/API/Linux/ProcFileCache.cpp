@@ -0,0 +1,229 @@
+#include "stdafx.h"
+#include "ProcFileCache.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/resource.h>
+
+#define FD_UNAVAILABLE	(-2) // the file can not be opened, e.g. /proc/<pid>/io of a foreign process
+
+// Note: ENOENT when opening, ESRCH when reading an already open file, anything else like EACCES is specific to the file
+#define PROCESS_GONE(e)	((e) == ENOENT || (e) == ESRCH)
+
+static const char* g_ProcFileNames[CProcFileCache::eFileCount] = { "stat", "statm", "io", "status" };
+
+CProcFileCache::CProcFileCache()
+{
+	m_MaxOpen = 0;
+	m_OpenCount = 0;
+}
+
+CProcFileCache::~CProcFileCache()
+{
+	Clear();
+}
+
+void CProcFileCache::SetMaxOpen(int MaxOpen)
+{
+	// Note: the default soft limit is often only 1024, we need about twice the budget as we must leave enough descriptors for everything else
+	struct rlimit Limit;
+	if (MaxOpen > 0 && getrlimit(RLIMIT_NOFILE, &Limit) == 0 && Limit.rlim_cur != RLIM_INFINITY)
+	{
+		rlim_t Wanted = (rlim_t)MaxOpen * 2;
+		if (Limit.rlim_cur < Wanted)
+		{
+			struct rlimit NewLimit = Limit;
+			NewLimit.rlim_cur = (Limit.rlim_max == RLIM_INFINITY || Limit.rlim_max > Wanted) ? Wanted : Limit.rlim_max;
+			if (setrlimit(RLIMIT_NOFILE, &NewLimit) == 0)
+				Limit = NewLimit;
+		}
+
+		if (MaxOpen > (int)(Limit.rlim_cur / 2))
+			MaxOpen = Limit.rlim_cur / 2;
+	}
+
+	QMutexLocker Locker(&m_Mutex);
+	m_MaxOpen = qMax(MaxOpen, 0);
+	Trim();
+}
+
+CProcFileCache::SEntry* CProcFileCache::Touch(quint64 ProcessId, quint64 StartTime)
+{
+	QHash<quint64, SEntry>::iterator I = m_Entries.find(ProcessId);
+	if (I != m_Entries.end() && StartTime != 0 && I->StartTime != 0 && I->StartTime != StartTime)
+	{
+		// the pid was reused, the cached descriptors belong to the old process
+		EvictEntry(ProcessId);
+		I = m_Entries.end();
+	}
+
+	if (I == m_Entries.end())
+	{
+		SEntry Entry;
+		Entry.StartTime = StartTime;
+		for (int i = 0; i < eFileCount; i++)
+			Entry.Fds[i] = -1;
+		Entry.Readers = 0;
+		I = m_Entries.insert(ProcessId, Entry);
+	}
+	else if (I->StartTime == 0)
+		I->StartTime = StartTime;
+
+	return &I.value();
+}
+
+int CProcFileCache::OpenFile(SEntry* pEntry, quint64 ProcessId, EFile File, bool bAllowUncached, bool& bCached)
+{
+	bCached = true;
+	int& fd = pEntry->Fds[File];
+	if (fd != -1)
+		return fd == FD_UNAVAILABLE ? -1 : fd;
+
+	// Note: once the budget is used up we don't evict anything, all processes are read each update in the same order,
+	//			so evicting would always drop the descriptor needed next, instead the remaining files are read uncached
+	bool bCache = m_OpenCount < m_MaxOpen;
+	if (!bCache && !bAllowUncached)
+		return -1;
+
+	char Path[64];
+	sprintf(Path, "/proc/%llu/%s", ProcessId, g_ProcFileNames[File]);
+	int NewFd = open(Path, O_RDONLY | O_CLOEXEC);
+	if (NewFd == -1)
+	{
+		if (!PROCESS_GONE(errno))
+			fd = FD_UNAVAILABLE; // don't retry on every update
+		else if (pEntry->Readers == 0)
+			EvictEntry(ProcessId);
+		return -1;
+	}
+
+	if (!bCache)
+	{
+		bCached = false;
+		return NewFd;
+	}
+
+	fd = NewFd;
+	m_OpenCount++;
+	return fd;
+}
+
+int CProcFileCache::Open(quint64 ProcessId, quint64 StartTime, EFile File)
+{
+	QMutexLocker Locker(&m_Mutex);
+	bool bCached;
+	return OpenFile(Touch(ProcessId, StartTime), ProcessId, File, false, bCached);
+}
+
+bool CProcFileCache::Read(quint64 ProcessId, quint64 StartTime, EFile File, QByteArray& Buffer)
+{
+	QMutexLocker Locker(&m_Mutex);
+	SEntry* pEntry = Touch(ProcessId, StartTime);
+	bool bCached;
+	int fd = OpenFile(pEntry, ProcessId, File, true, bCached);
+	if (fd == -1)
+		return false;
+	// Note: each process is updated by only one worker, so only Trim could close the descriptor while we read
+	pEntry->Readers++;
+	Locker.unlock();
+
+	// Note: proc files report a size of 0, a short read means we got everything
+	Buffer.resize(qMax(Buffer.capacity(), 4096));
+	int Length = 0;
+	int Error = 0;
+	for (;;)
+	{
+		ssize_t Read = pread(fd, Buffer.data() + Length, Buffer.size() - Length, Length);
+		if (Read < 0)
+		{
+			Error = errno;
+			break;
+		}
+		Length += Read;
+		if (Length < Buffer.size())
+			break;
+		Buffer.resize(Buffer.size() * 2);
+	}
+	Buffer.resize(Length);
+
+	if (!bCached)
+		close(fd);
+
+	Locker.relock();
+	// Note: the entry pointer may be stale by now, as an insert of an other process may have rehashed the table
+	QHash<quint64, SEntry>::iterator I = m_Entries.find(ProcessId);
+	if (I != m_Entries.end())
+	{
+		I->Readers--;
+
+		// Note: once the process has exited its open proc files fail with ESRCH, 
+		//			some files check the access only on read, than we remember that this one file is not readable
+		if (Error != 0)
+		{
+			if (PROCESS_GONE(Error))
+				EvictEntry(ProcessId);
+			else if (bCached)
+				CloseFile(I.value(), File, FD_UNAVAILABLE);
+			else
+				I->Fds[File] = FD_UNAVAILABLE;
+		}
+	}
+	return Error == 0;
+}
+
+void CProcFileCache::CloseFile(SEntry& Entry, EFile File, int State)
+{
+	if (Entry.Fds[File] >= 0)
+	{
+		close(Entry.Fds[File]);
+		m_OpenCount--;
+	}
+	Entry.Fds[File] = State;
+}
+
+void CProcFileCache::CloseEntry(SEntry& Entry)
+{
+	for (int i = 0; i < eFileCount; i++)
+		CloseFile(Entry, (EFile)i, -1);
+}
+
+void CProcFileCache::Evict(quint64 ProcessId)
+{
+	QMutexLocker Locker(&m_Mutex);
+	EvictEntry(ProcessId);
+}
+
+void CProcFileCache::EvictEntry(quint64 ProcessId)
+{
+	QHash<quint64, SEntry>::iterator I = m_Entries.find(ProcessId);
+	if (I == m_Entries.end())
+		return;
+
+	CloseEntry(I.value());
+	m_Entries.erase(I);
+}
+
+void CProcFileCache::Clear()
+{
+	QMutexLocker Locker(&m_Mutex);
+	for (QHash<quint64, SEntry>::iterator I = m_Entries.begin(); I != m_Entries.end(); ++I)
+		CloseEntry(I.value());
+	m_Entries.clear();
+}
+
+void CProcFileCache::Trim()
+{
+	// only needed when the budget was lowered, close descriptors of any processes not being read right now,
+	// the entries are kept so that we still remember which files are not readable
+	for (QHash<quint64, SEntry>::iterator I = m_Entries.begin(); I != m_Entries.end() && m_OpenCount > m_MaxOpen; ++I)
+	{
+		if (I->Readers > 0)
+			continue;
+		for (int i = 0; i < eFileCount; i++)
+		{
+			if (I->Fds[i] >= 0)
+				CloseFile(I.value(), (EFile)i, -1);
+		}
+	}
+}
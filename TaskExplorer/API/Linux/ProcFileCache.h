@@ -0,0 +1,57 @@
+#pragma once
+
+// Keeps the frequently read /proc/<pid>/ files open between updates,
+// so that a refresh is a single pread instead of open, read, read and close.
+// Note: Read may be called from the process update workers, the reads itself are done without holding the lock
+class CProcFileCache
+{
+public:
+	CProcFileCache();
+	~CProcFileCache();
+
+	enum EFile
+	{
+		eStat = 0,
+		eStatm,
+		eIo,
+		eStatus,
+		eFileCount
+	};
+
+	// raises the soft descriptor limit as far as needed and allowed, then sets the budget of cached descriptors
+	void			SetMaxOpen(int MaxOpen);
+	int				GetMaxOpen() const		{ return m_MaxOpen; }
+	int				GetOpenCount() const	{ return m_OpenCount; }
+
+	// StartTime may be 0 if not yet known, when known it is used to detect a reused pid
+	bool			Read(quint64 ProcessId, quint64 StartTime, EFile File, QByteArray& Buffer);
+
+	// returns the cached descriptor for batched reads, or -1 if the file can not be opened or the budget is used up
+	// Note: the descriptor stays valid until the process is evicted,
+	//			the caller must make sure no Read runs concurrently while the descriptor is in use
+	int				Open(quint64 ProcessId, quint64 StartTime, EFile File);
+
+	void			Evict(quint64 ProcessId);
+	void			Clear();
+
+protected:
+	struct SEntry
+	{
+		quint64					StartTime;
+		int						Fds[eFileCount];
+		int						Readers; // reads in progress, such entries must not be closed
+	};
+
+	SEntry*			Touch(quint64 ProcessId, quint64 StartTime);
+	int				OpenFile(SEntry* pEntry, quint64 ProcessId, EFile File, bool bAllowUncached, bool& bCached);
+	void			CloseFile(SEntry& Entry, EFile File, int State);
+	void			EvictEntry(quint64 ProcessId);
+	void			CloseEntry(SEntry& Entry);
+	void			Trim();
+
+	QMutex					m_Mutex;
+	QHash<quint64, SEntry>	m_Entries;
+
+	int						m_MaxOpen;
+	int						m_OpenCount;
+};
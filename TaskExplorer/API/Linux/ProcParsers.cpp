@@ -0,0 +1,156 @@
+#include "stdafx.h"
+#include "ProcParsers.h"
+
+quint64 ParseKeyValues(const char* pPos, const char* pEnd, const char* const* pKeys, int KeyCount, quint64* pValues)
+{
+	quint64 FoundMask = 0;
+	quint64 AllMask = KeyCount >= 64 ? ~0ULL : (1ULL << KeyCount) - 1;
+	for (; pPos < pEnd && FoundMask != AllMask; pPos = NextLine(pPos, pEnd))
+	{
+		const char* pLineEnd = NextLine(pPos, pEnd);
+		const char* pColon = (const char*)memchr(pPos, ':', pLineEnd - pPos);
+		if (!pColon)
+			continue;
+		size_t KeyLength = pColon - pPos;
+
+		for (int i = 0; i < KeyCount; i++)
+		{
+			if (strncmp(pPos, pKeys[i], KeyLength) != 0 || pKeys[i][KeyLength] != 0)
+				continue;
+
+			const char* pValue = pColon + 1;
+			pValues[i] = ParseULong(pValue, pLineEnd);
+			FoundMask |= (1ULL << i);
+			break;
+		}
+	}
+	return FoundMask;
+}
+
+bool ParseProcStat(const char* pPos, const char* pEnd, SProcStat& Stat)
+{
+	if (pPos >= pEnd)
+		return false;
+
+	// Note: the process name is in brackets and may contain spaces and brackets itself, hence we look for the last ')'
+	const char* pNameStart = (const char*)memchr(pPos, '(', pEnd - pPos);
+	const char* pNameEnd = pEnd;
+	while (pNameEnd > pPos && *(pNameEnd - 1) != ')')
+		pNameEnd--;
+	if (!pNameStart || pNameEnd <= pNameStart + 1)
+		return false;
+	pNameEnd--; // points to the ')'
+
+	Stat.pName = pNameStart + 1;
+	Stat.NameLength = pNameEnd - Stat.pName;
+
+	// Fields after the name starting with index 0:
+	// state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt utime stime cutime cstime priority nice num_threads itrealvalue starttime vsize rss ...
+	pPos = pNameEnd + 1;
+	SkipSpaces(pPos, pEnd);
+	if (pPos >= pEnd)
+		return false;
+	Stat.State = *pPos++;
+
+	Stat.ParentId = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // pgrp
+	Stat.SessionId = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // tty_nr
+	SkipField(pPos, pEnd); // tpgid
+	Stat.Flags = ParseULong(pPos, pEnd);
+	Stat.MinorFaults = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // cminflt
+	Stat.MajorFaults = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // cmajflt
+	Stat.UserTime = ParseULong(pPos, pEnd);
+	Stat.KernelTime = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // cutime
+	SkipField(pPos, pEnd); // cstime
+	Stat.Priority = ParseLong(pPos, pEnd);
+	Stat.Nice = ParseLong(pPos, pEnd);
+	Stat.NumThreads = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // itrealvalue
+	Stat.StartTime = ParseULong(pPos, pEnd);
+	Stat.VirtualSize = ParseULong(pPos, pEnd);
+
+	// the rss must be followed by a further field, if it is not the file was truncated
+	SkipSpaces(pPos, pEnd);
+	if (pPos >= pEnd || *pPos < '0' || *pPos > '9')
+		return false;
+	Stat.ResidentPages = ParseULong(pPos, pEnd);
+	return pPos < pEnd && *pPos == ' ';
+}
+
+bool ParseProcStatm(const char* pPos, const char* pEnd, SProcStatm& Statm)
+{
+	// Fields: size resident shared text lib data dt (in pages)
+	Statm.Size = ParseULong(pPos, pEnd);
+	Statm.Resident = ParseULong(pPos, pEnd);
+	Statm.Shared = ParseULong(pPos, pEnd);
+	Statm.Text = ParseULong(pPos, pEnd);
+	SkipField(pPos, pEnd); // lib, always 0
+	SkipSpaces(pPos, pEnd);
+	if (pPos >= pEnd || *pPos < '0' || *pPos > '9')
+		return false;
+	Statm.Data = ParseULong(pPos, pEnd);
+	return true;
+}
+
+bool ParseProcIo(const char* pPos, const char* pEnd, SProcIo& Io)
+{
+	static const char* IoKeys[] = { "rchar", "wchar", "syscr", "syscw", "read_bytes", "write_bytes" };
+	quint64 Values[6];
+	memset(Values, 0, sizeof(Values));
+	if (ParseKeyValues(pPos, pEnd, IoKeys, 6, Values) == 0)
+		return false;
+
+	Io.ReadChars = Values[0];
+	Io.WriteChars = Values[1];
+	Io.ReadCalls = Values[2];
+	Io.WriteCalls = Values[3];
+	Io.ReadBytes = Values[4];
+	Io.WriteBytes = Values[5];
+	return true;
+}
+
+bool ParseProcStatus(const char* pPos, const char* pEnd, SProcStatus& Status)
+{
+	static const char* StatusKeys[] = { "voluntary_ctxt_switches", "nonvoluntary_ctxt_switches", "VmSwap" };
+	quint64 Values[3];
+	memset(Values, 0, sizeof(Values));
+	if (ParseKeyValues(pPos, pEnd, StatusKeys, 3, Values) == 0)
+		return false;
+
+	Status.VoluntaryCtxtSwitches = Values[0];
+	Status.NonVoluntaryCtxtSwitches = Values[1];
+	Status.SwapSize = Values[2] * 1024; // in kB, missing for kernel threads
+	return true;
+}
+
+bool ParseProcNetDevLine(const char*& pPos, const char* pEnd, SProcNetDevEntry& Entry)
+{
+	// Format: name: rx_bytes rx_packets errs drop fifo frame compressed multicast tx_bytes tx_packets ...
+	const char* pLineEnd = NextLine(pPos, pEnd);
+	const char* pLine = pPos;
+	pPos = pLineEnd;
+
+	SkipSpaces(pLine, pLineEnd);
+	// Note: on old kernels there is no space between the colon and large counters
+	const char* pColon = (const char*)memchr(pLine, ':', pLineEnd - pLine);
+	if (!pColon || pColon == pLine)
+		return false;
+	Entry.pName = pLine;
+	Entry.NameLength = pColon - pLine;
+	pLine = pColon + 1;
+
+	Entry.ReceiveBytes = ParseULong(pLine, pLineEnd);
+	Entry.ReceivePackets = ParseULong(pLine, pLineEnd);
+	for (int i = 0; i < 6; i++) // errs drop fifo frame compressed multicast
+		SkipField(pLine, pLineEnd);
+	SkipSpaces(pLine, pLineEnd);
+	if (pLine >= pLineEnd)
+		return false;
+	Entry.SendBytes = ParseULong(pLine, pLineEnd);
+	Entry.SendPackets = ParseULong(pLine, pLineEnd);
+	return true;
+}
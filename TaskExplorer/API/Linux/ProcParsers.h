@@ -0,0 +1,143 @@
+#pragma once
+
+// Parsers for the text files in /proc, they work in place on the range [pPos, pEnd) of a reused read buffer,
+// the buffer does not need to be null terminated and no temporary strings are created for numeric fields.
+
+static inline void SkipSpaces(const char*& pPos, const char* pEnd)
+{
+	while (pPos < pEnd && (*pPos == ' ' || *pPos == '\t'))
+		pPos++;
+}
+
+static inline void SkipField(const char*& pPos, const char* pEnd)
+{
+	SkipSpaces(pPos, pEnd);
+	while (pPos < pEnd && *pPos != ' ' && *pPos != '\t' && *pPos != '\n')
+		pPos++;
+}
+
+static inline quint64 ParseULong(const char*& pPos, const char* pEnd)
+{
+	SkipSpaces(pPos, pEnd);
+	quint64 Value = 0;
+	while (pPos < pEnd && *pPos >= '0' && *pPos <= '9')
+		Value = Value * 10 + (*pPos++ - '0');
+	return Value;
+}
+
+static inline qint64 ParseLong(const char*& pPos, const char* pEnd)
+{
+	SkipSpaces(pPos, pEnd);
+	bool bNegative = (pPos < pEnd && *pPos == '-');
+	if (bNegative)
+		pPos++;
+	qint64 Value = (qint64)ParseULong(pPos, pEnd);
+	return bNegative ? -Value : Value;
+}
+
+static inline quint64 ParseHex(const char*& pPos, const char* pEnd)
+{
+	quint64 Value = 0;
+	for (; pPos < pEnd; pPos++)
+	{
+		char c = *pPos;
+		if (c >= '0' && c <= '9')		Value = (Value << 4) | (c - '0');
+		else if (c >= 'a' && c <= 'f')	Value = (Value << 4) | (c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F')	Value = (Value << 4) | (c - 'A' + 10);
+		else
+			break;
+	}
+	return Value;
+}
+
+static inline const char* NextLine(const char* pPos, const char* pEnd)
+{
+	const char* pNext = (const char*)memchr(pPos, '\n', pEnd - pPos);
+	return pNext ? pNext + 1 : pEnd;
+}
+
+static inline bool TakeKey(const char*& pPos, const char* pEnd, const char* Key, size_t Length)
+{
+	if ((size_t)(pEnd - pPos) < Length || memcmp(pPos, Key, Length) != 0)
+		return false;
+	pPos += Length;
+	return true;
+}
+
+#define TAKE_KEY(p, e, k) TakeKey(p, e, k, sizeof(k) - 1)
+
+// Parses "Key: Value" files like meminfo, status, io or smaps_rollup, the values of the found keys are stored in pValues,
+// keys not present are left untouched. Returns a bit mask of the found keys, hence at most 64 keys can be looked up.
+quint64 ParseKeyValues(const char* pPos, const char* pEnd, const char* const* pKeys, int KeyCount, quint64* pValues);
+
+// /proc/<pid>/stat
+struct SProcStat
+{
+	const char*	pName; // points into the buffer, not null terminated
+	int			NameLength;
+	char		State;
+	quint64		ParentId;
+	quint64		SessionId;
+	quint64		Flags;
+	quint64		MinorFaults;
+	quint64		MajorFaults;
+	quint64		UserTime; // in clock ticks
+	quint64		KernelTime;
+	qint64		Priority;
+	qint64		Nice;
+	quint64		NumThreads;
+	quint64		StartTime; // in clock ticks since boot
+	quint64		VirtualSize;
+	quint64		ResidentPages;
+};
+
+bool ParseProcStat(const char* pPos, const char* pEnd, SProcStat& Stat);
+
+// /proc/<pid>/statm, all values are in pages
+struct SProcStatm
+{
+	quint64		Size;
+	quint64		Resident;
+	quint64		Shared;
+	quint64		Text;
+	quint64		Data;
+};
+
+bool ParseProcStatm(const char* pPos, const char* pEnd, SProcStatm& Statm);
+
+// /proc/<pid>/io
+struct SProcIo
+{
+	quint64		ReadChars;
+	quint64		WriteChars;
+	quint64		ReadCalls;
+	quint64		WriteCalls;
+	quint64		ReadBytes;
+	quint64		WriteBytes;
+};
+
+bool ParseProcIo(const char* pPos, const char* pEnd, SProcIo& Io);
+
+// /proc/<pid>/status, only the values we don't get cheaper from stat
+struct SProcStatus
+{
+	quint64		VoluntaryCtxtSwitches;
+	quint64		NonVoluntaryCtxtSwitches;
+	quint64		SwapSize; // in bytes
+};
+
+bool ParseProcStatus(const char* pPos, const char* pEnd, SProcStatus& Status);
+
+// one interface line of /proc/net/dev
+struct SProcNetDevEntry
+{
+	const char*	pName; // points into the buffer, not null terminated
+	int			NameLength;
+	quint64		ReceiveBytes;
+	quint64		ReceivePackets;
+	quint64		SendBytes;
+	quint64		SendPackets;
+};
+
+// parses the line at pPos and advances pPos to the next line, the two header lines are skipped by the caller
+bool ParseProcNetDevLine(const char*& pPos, const char* pEnd, SProcNetDevEntry& Entry);
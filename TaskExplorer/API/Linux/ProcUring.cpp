@@ -0,0 +1,197 @@
+#include "stdafx.h"
+#include "ProcUring.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define HAS_IO_URING
+#endif
+#endif
+
+CProcUring::CProcUring()
+{
+	m_Ring = -1;
+	m_Entries = 0;
+
+	m_pSqRing = MAP_FAILED;
+	m_SqRingSize = 0;
+	m_pCqRing = MAP_FAILED;
+	m_CqRingSize = 0;
+	m_pSqes = MAP_FAILED;
+	m_SqesSize = 0;
+
+	m_pSqTail = NULL;
+	m_pSqMask = NULL;
+	m_pSqArray = NULL;
+	m_pCqHead = NULL;
+	m_pCqTail = NULL;
+	m_pCqMask = NULL;
+	m_pCqes = NULL;
+}
+
+CProcUring::~CProcUring()
+{
+	UnInit();
+}
+
+bool CProcUring::IsSupported()
+{
+#ifdef HAS_IO_URING
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CProcUring::Init(quint32 Entries)
+{
+#ifdef HAS_IO_URING
+	struct io_uring_params Params;
+	memset(&Params, 0, sizeof(Params));
+
+	// Note: this fails if the kernel is to old or io_uring is disabled, e.g. by the kernel.io_uring_disabled sysctl
+	m_Ring = syscall(__NR_io_uring_setup, Entries, &Params);
+	if (m_Ring == -1)
+		return false;
+	m_Entries = Params.sq_entries;
+
+	m_SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+	m_CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(struct io_uring_cqe);
+	bool bSingleMap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (bSingleMap)
+		m_SqRingSize = m_CqRingSize = qMax(m_SqRingSize, m_CqRingSize);
+
+	m_pSqRing = mmap(NULL, m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQ_RING);
+	if (m_pSqRing == MAP_FAILED)
+	{
+		UnInit();
+		return false;
+	}
+
+	if (bSingleMap)
+		m_CqRingSize = 0; // shared with the sq ring, don't unmap it twice
+	else
+	{
+		m_pCqRing = mmap(NULL, m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_CQ_RING);
+		if (m_pCqRing == MAP_FAILED)
+		{
+			UnInit();
+			return false;
+		}
+	}
+	char* pCqRing = (char*)(bSingleMap ? m_pSqRing : m_pCqRing);
+
+	m_SqesSize = Params.sq_entries * sizeof(struct io_uring_sqe);
+	m_pSqes = mmap(NULL, m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQES);
+	if (m_pSqes == MAP_FAILED)
+	{
+		UnInit();
+		return false;
+	}
+
+	m_pSqTail = (unsigned*)((char*)m_pSqRing + Params.sq_off.tail);
+	m_pSqMask = (unsigned*)((char*)m_pSqRing + Params.sq_off.ring_mask);
+	m_pSqArray = (unsigned*)((char*)m_pSqRing + Params.sq_off.array);
+	m_pCqHead = (unsigned*)(pCqRing + Params.cq_off.head);
+	m_pCqTail = (unsigned*)(pCqRing + Params.cq_off.tail);
+	m_pCqMask = (unsigned*)(pCqRing + Params.cq_off.ring_mask);
+	m_pCqes = pCqRing + Params.cq_off.cqes;
+
+	m_Iovecs.resize(m_Entries);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void CProcUring::UnInit()
+{
+	if (m_pSqes != MAP_FAILED)
+		munmap(m_pSqes, m_SqesSize);
+	m_pSqes = MAP_FAILED;
+	if (m_pCqRing != MAP_FAILED && m_CqRingSize != 0)
+		munmap(m_pCqRing, m_CqRingSize);
+	m_pCqRing = MAP_FAILED;
+	if (m_pSqRing != MAP_FAILED)
+		munmap(m_pSqRing, m_SqRingSize);
+	m_pSqRing = MAP_FAILED;
+
+	if (m_Ring != -1)
+		close(m_Ring);
+	m_Ring = -1;
+	m_Entries = 0;
+}
+
+bool CProcUring::ReadBatch(SReadRequest* pRequests, int Count)
+{
+#ifdef HAS_IO_URING
+	if (m_Ring == -1 || Count > (int)m_Entries)
+		return false;
+	if (Count == 0)
+		return true;
+
+	// Note: we are the only producer, so we can read our own tail without synchronisation
+	unsigned Tail = *m_pSqTail;
+	unsigned Mask = *m_pSqMask;
+	for (int i = 0; i < Count; i++)
+	{
+		unsigned Index = Tail & Mask;
+		struct io_uring_sqe* pSqe = &((struct io_uring_sqe*)m_pSqes)[Index];
+		memset(pSqe, 0, sizeof(*pSqe));
+
+		// Note: we use READV as plain READ requires linux 5.6 while READV is available since 5.1
+		m_Iovecs[i].iov_base = pRequests[i].pBuffer;
+		m_Iovecs[i].iov_len = pRequests[i].Size;
+		pSqe->opcode = IORING_OP_READV;
+		pSqe->fd = pRequests[i].Fd;
+		pSqe->addr = (quint64)&m_Iovecs[i];
+		pSqe->len = 1;
+		pSqe->off = 0;
+		pSqe->user_data = i;
+
+		m_pSqArray[Index] = Index;
+		Tail++;
+
+		pRequests[i].Result = -EINPROGRESS;
+	}
+	__atomic_store_n(m_pSqTail, Tail, __ATOMIC_RELEASE);
+
+	int Submitted = 0;
+	int Completed = 0;
+	while (Completed < Count)
+	{
+		int ToSubmit = Count - Submitted;
+		int Ret = syscall(__NR_io_uring_enter, m_Ring, ToSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+		if (Ret < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			// Note: the ring is in an unknown state now, better not use it again
+			UnInit();
+			return false;
+		}
+		Submitted += Ret;
+
+		unsigned Head = *m_pCqHead;
+		unsigned CqTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+		unsigned CqMask = *m_pCqMask;
+		for (; Head != CqTail; Head++)
+		{
+			struct io_uring_cqe* pCqe = &((struct io_uring_cqe*)m_pCqes)[Head & CqMask];
+			if (pCqe->user_data < (quint64)Count)
+				pRequests[pCqe->user_data].Result = pCqe->res;
+			Completed++;
+		}
+		__atomic_store_n(m_pCqHead, Head, __ATOMIC_RELEASE);
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
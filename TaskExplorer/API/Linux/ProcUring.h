@@ -0,0 +1,54 @@
+#pragma once
+#include <sys/uio.h>
+
+// Minimal io_uring wrapper used to read many small /proc files with one system call,
+// we use the raw syscalls so that we don't depend on liburing.
+// Note: this class is *NOT Thread Safe*, it must only be used from the API thread
+class CProcUring
+{
+public:
+	CProcUring();
+	~CProcUring();
+
+	static bool		IsSupported();
+
+	bool			Init(quint32 Entries);
+	bool			IsOpen() const		{ return m_Ring != -1; }
+	quint32			GetEntries() const	{ return m_Entries; }
+
+	struct SReadRequest
+	{
+		int			Fd;
+		char*		pBuffer;
+		quint32		Size;
+		int			Result; // bytes read or -errno
+	};
+
+	// Reads up to GetEntries() files from offset 0 and waits for all of them to complete,
+	// returns false if the ring itself failed, the caller must than fall back to plain reads
+	bool			ReadBatch(SReadRequest* pRequests, int Count);
+
+protected:
+	void			UnInit();
+
+	int				m_Ring;
+	quint32			m_Entries;
+
+	void*			m_pSqRing;
+	size_t			m_SqRingSize;
+	void*			m_pCqRing;
+	size_t			m_CqRingSize;
+	void*			m_pSqes;
+	size_t			m_SqesSize;
+
+	// pointers into the shared rings
+	unsigned*		m_pSqTail;
+	unsigned*		m_pSqMask;
+	unsigned*		m_pSqArray;
+	unsigned*		m_pCqHead;
+	unsigned*		m_pCqTail;
+	unsigned*		m_pCqMask;
+	void*			m_pCqes;
+
+	QVector<struct iovec> m_Iovecs;
+};
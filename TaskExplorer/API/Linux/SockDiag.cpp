@@ -0,0 +1,304 @@
+#include "stdafx.h"
+#include "SockDiag.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/unix_diag.h>
+#include <linux/tcp.h>
+#include <stddef.h>
+
+// Maps the linux TCP_* states (1 - 12) to the MIB_TCP_STATE values used by CSocketInfo
+static const quint32 g_TcpStateMap[] = {
+	0,
+	5,	// TCP_ESTABLISHED	-> MIB_TCP_STATE_ESTAB
+	3,	// TCP_SYN_SENT		-> MIB_TCP_STATE_SYN_SENT
+	4,	// TCP_SYN_RECV		-> MIB_TCP_STATE_SYN_RCVD
+	6,	// TCP_FIN_WAIT1	-> MIB_TCP_STATE_FIN_WAIT1
+	7,	// TCP_FIN_WAIT2	-> MIB_TCP_STATE_FIN_WAIT2
+	11,	// TCP_TIME_WAIT	-> MIB_TCP_STATE_TIME_WAIT
+	1,	// TCP_CLOSE		-> MIB_TCP_STATE_CLOSED
+	8,	// TCP_CLOSE_WAIT	-> MIB_TCP_STATE_CLOSE_WAIT
+	10,	// TCP_LAST_ACK		-> MIB_TCP_STATE_LAST_ACK
+	2,	// TCP_LISTEN		-> MIB_TCP_STATE_LISTEN
+	9,	// TCP_CLOSING		-> MIB_TCP_STATE_CLOSING
+	4,	// TCP_NEW_SYN_RECV	-> MIB_TCP_STATE_SYN_RCVD
+};
+
+CSockDiag::CSockDiag()
+{
+	m_Socket = -1;
+}
+
+CSockDiag::~CSockDiag()
+{
+	if (m_Socket != -1)
+		close(m_Socket);
+}
+
+bool CSockDiag::Open()
+{
+	if (m_Socket != -1)
+		return true;
+
+	m_Socket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+	if (m_Socket == -1)
+		return false;
+
+	// Note: with many sockets the dump comes in many messages, a large buffer reduces the number of recv calls
+	m_Buffer.resize(64 * 1024);
+	return true;
+}
+
+bool CSockDiag::Request(const void* pRequest, size_t Length)
+{
+	struct sockaddr_nl Address;
+	memset(&Address, 0, sizeof(Address));
+	Address.nl_family = AF_NETLINK;
+
+	return sendto(m_Socket, pRequest, Length, 0, (struct sockaddr*)&Address, sizeof(Address)) != -1;
+}
+
+bool CSockDiag::DumpInet(int Family, int Protocol, QVector<SSockDiagEntry>& Entries)
+{
+	if (m_Socket == -1)
+		return false;
+
+	struct
+	{
+		struct nlmsghdr			Header;
+		struct inet_diag_req_v2	Request;
+	} Message;
+	memset(&Message, 0, sizeof(Message));
+
+	Message.Header.nlmsg_len = sizeof(Message);
+	Message.Header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+	Message.Header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	Message.Request.sdiag_family = Family;
+	Message.Request.sdiag_protocol = Protocol;
+	Message.Request.idiag_states = ~0U; // all states
+	// Note: for TCP we let the kernel include the tcp_info in the same dump, this gives us byte counters and RTT
+	if (Protocol == IPPROTO_TCP)
+		Message.Request.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+
+	if (!Request(&Message, sizeof(Message)))
+		return false;
+
+	return Receive(Entries, Protocol == IPPROTO_TCP ? NET_TYPE_PROTOCOL_TCP : NET_TYPE_PROTOCOL_UDP);
+}
+
+bool CSockDiag::DumpUnix(QVector<SSockDiagEntry>& Entries)
+{
+	if (m_Socket == -1)
+		return false;
+
+	struct
+	{
+		struct nlmsghdr			Header;
+		struct unix_diag_req	Request;
+	} Message;
+	memset(&Message, 0, sizeof(Message));
+
+	Message.Header.nlmsg_len = sizeof(Message);
+	Message.Header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+	Message.Header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	Message.Request.sdiag_family = AF_UNIX;
+	Message.Request.udiag_states = ~0U; // all states
+	Message.Request.udiag_show = UDIAG_SHOW_NAME | UDIAG_SHOW_UID;
+
+	if (!Request(&Message, sizeof(Message)))
+		return false;
+
+	return Receive(Entries, NET_TYPE_UNIX);
+}
+
+bool CSockDiag::Receive(QVector<SSockDiagEntry>& Entries, quint32 ProtocolType)
+{
+	for (;;)
+	{
+		ssize_t Length = recv(m_Socket, m_Buffer.data(), m_Buffer.size(), 0);
+		if (Length == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		for (const struct nlmsghdr* pHeader = (const struct nlmsghdr*)m_Buffer.constData(); NLMSG_OK(pHeader, Length); pHeader = NLMSG_NEXT(pHeader, Length))
+		{
+			if (pHeader->nlmsg_type == NLMSG_DONE)
+				return true;
+			if (pHeader->nlmsg_type == NLMSG_ERROR)
+				return false;
+			if (pHeader->nlmsg_type != SOCK_DIAG_BY_FAMILY)
+				continue;
+
+			Entries.append(SSockDiagEntry());
+			if (ProtocolType == NET_TYPE_UNIX)
+				ParseUnix(pHeader, Entries.last());
+			else
+				ParseInet(pHeader, ProtocolType, Entries.last());
+		}
+	}
+}
+
+void CSockDiag::ParseInet(const struct nlmsghdr* pHeader, quint32 ProtocolType, SSockDiagEntry& Entry)
+{
+	const struct inet_diag_msg* pMessage = (const struct inet_diag_msg*)NLMSG_DATA(pHeader);
+
+	bool bIPv6 = pMessage->idiag_family == AF_INET6;
+
+	Entry.LocalPort = ntohs(pMessage->id.idiag_sport);
+	Entry.RemotePort = ntohs(pMessage->id.idiag_dport);
+	if (bIPv6)
+	{
+		Entry.LocalAddress = QHostAddress((const quint8*)pMessage->id.idiag_src);
+		Entry.RemoteAddress = QHostAddress((const quint8*)pMessage->id.idiag_dst);
+	}
+	else
+	{
+		Entry.LocalAddress = QHostAddress(ntohl(pMessage->id.idiag_src[0]));
+		Entry.RemoteAddress = QHostAddress(ntohl(pMessage->id.idiag_dst[0]));
+	}
+
+	Entry.Interface = pMessage->id.idiag_if;
+	Entry.Cookie = (quint64)pMessage->id.idiag_cookie[0] | ((quint64)pMessage->id.idiag_cookie[1] << 32);
+	Entry.Inode = pMessage->idiag_inode;
+	Entry.UserId = pMessage->idiag_uid;
+
+	Entry.ProtocolType = ProtocolType | (bIPv6 ? NET_TYPE_NETWORK_IPV6 : NET_TYPE_NETWORK_IPV4);
+	// Note: UDP sockets report TCP_CLOSE when they are not connected, for them we leave the state unset
+	if (ProtocolType == NET_TYPE_PROTOCOL_TCP && pMessage->idiag_state < sizeof(g_TcpStateMap) / sizeof(quint32))
+		Entry.State = g_TcpStateMap[pMessage->idiag_state];
+
+	int Length = pHeader->nlmsg_len - NLMSG_LENGTH(sizeof(*pMessage));
+	for (const struct rtattr* pAttr = (const struct rtattr*)(pMessage + 1); RTA_OK(pAttr, Length); pAttr = RTA_NEXT(pAttr, Length))
+	{
+		if (pAttr->rta_type == INET_DIAG_INFO)
+			ParseTcpInfo((const struct tcp_info*)RTA_DATA(pAttr), RTA_PAYLOAD(pAttr), Entry);
+	}
+}
+
+void CSockDiag::ParseTcpInfo(const struct tcp_info* pInfo, size_t Size, SSockDiagEntry& Entry)
+{
+	// Note: older kernels return a shorter structure, only use the fields which are present
+#define HAS_TCP_INFO(x) (Size >= offsetof(struct tcp_info, x) + sizeof(pInfo->x))
+
+	if (!HAS_TCP_INFO(tcpi_total_retrans))
+		return;
+
+	Entry.HasTcpInfo = true;
+	Entry.RoundTripTime = pInfo->tcpi_rtt;
+	Entry.RoundTripTimeVar = pInfo->tcpi_rttvar;
+	Entry.Retransmissions = pInfo->tcpi_total_retrans;
+	Entry.CongestionWindow = pInfo->tcpi_snd_cwnd;
+
+	if (HAS_TCP_INFO(tcpi_bytes_received)) // 4.1+
+	{
+		Entry.BytesSent = pInfo->tcpi_bytes_acked;
+		Entry.BytesReceived = pInfo->tcpi_bytes_received;
+	}
+	if (HAS_TCP_INFO(tcpi_segs_in)) // 4.2+
+	{
+		Entry.SegmentsSent = pInfo->tcpi_segs_out;
+		Entry.SegmentsReceived = pInfo->tcpi_segs_in;
+	}
+
+#undef HAS_TCP_INFO
+}
+
+void CSockDiag::ParseUnix(const struct nlmsghdr* pHeader, SSockDiagEntry& Entry)
+{
+	const struct unix_diag_msg* pMessage = (const struct unix_diag_msg*)NLMSG_DATA(pHeader);
+
+	Entry.ProtocolType = NET_TYPE_UNIX;
+	Entry.Inode = pMessage->udiag_ino;
+	Entry.Cookie = (quint64)pMessage->udiag_cookie[0] | ((quint64)pMessage->udiag_cookie[1] << 32);
+
+	int Length = pHeader->nlmsg_len - NLMSG_LENGTH(sizeof(*pMessage));
+	for (const struct rtattr* pAttr = (const struct rtattr*)(pMessage + 1); RTA_OK(pAttr, Length); pAttr = RTA_NEXT(pAttr, Length))
+	{
+		switch (pAttr->rta_type)
+		{
+		case UNIX_DIAG_NAME:
+		{
+			const char* pName = (const char*)RTA_DATA(pAttr);
+			int NameLength = RTA_PAYLOAD(pAttr);
+			// Note: abstract socket names start with a null character, they are usually displayed with a leading @
+			if (NameLength > 0 && pName[0] == 0)
+				Entry.Path = "@" + QString::fromLocal8Bit(pName + 1, NameLength - 1);
+			else
+				Entry.Path = QString::fromLocal8Bit(pName, strnlen(pName, NameLength));
+			break;
+		}
+		case UNIX_DIAG_UID:
+			Entry.UserId = *(const quint32*)RTA_DATA(pAttr);
+			break;
+		}
+	}
+}
+
+bool CSockDiag::Destroy(const SSockDiagEntry& Entry)
+{
+	if (m_Socket == -1 || (Entry.ProtocolType & NET_TYPE_PROTOCOL_TCP) == 0)
+		return false;
+
+	struct
+	{
+		struct nlmsghdr			Header;
+		struct inet_diag_req_v2	Request;
+	} Message;
+	memset(&Message, 0, sizeof(Message));
+
+	Message.Header.nlmsg_len = sizeof(Message);
+	Message.Header.nlmsg_type = SOCK_DESTROY;
+	Message.Header.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+	Message.Request.sdiag_protocol = IPPROTO_TCP;
+	Message.Request.idiag_states = ~0U;
+
+	struct inet_diag_sockid& Id = Message.Request.id;
+	Id.idiag_sport = htons(Entry.LocalPort);
+	Id.idiag_dport = htons(Entry.RemotePort);
+	if ((Entry.ProtocolType & NET_TYPE_NETWORK_IPV6) != 0)
+	{
+		Message.Request.sdiag_family = AF_INET6;
+		Q_IPV6ADDR LocalAddress = Entry.LocalAddress.toIPv6Address();
+		Q_IPV6ADDR RemoteAddress = Entry.RemoteAddress.toIPv6Address();
+		memcpy(Id.idiag_src, &LocalAddress, sizeof(Id.idiag_src));
+		memcpy(Id.idiag_dst, &RemoteAddress, sizeof(Id.idiag_dst));
+	}
+	else
+	{
+		Message.Request.sdiag_family = AF_INET;
+		Id.idiag_src[0] = htonl(Entry.LocalAddress.toIPv4Address());
+		Id.idiag_dst[0] = htonl(Entry.RemoteAddress.toIPv4Address());
+	}
+	Id.idiag_if = Entry.Interface;
+	Id.idiag_cookie[0] = (quint32)Entry.Cookie;
+	Id.idiag_cookie[1] = (quint32)(Entry.Cookie >> 32);
+
+	if (!Request(&Message, sizeof(Message)))
+		return false;
+
+	// wait for the acknowledgement
+	ssize_t Length = recv(m_Socket, m_Buffer.data(), m_Buffer.size(), 0);
+	if (Length < (ssize_t)NLMSG_LENGTH(sizeof(struct nlmsgerr)))
+		return false;
+
+	const struct nlmsghdr* pHeader = (const struct nlmsghdr*)m_Buffer.constData();
+	if (pHeader->nlmsg_type != NLMSG_ERROR)
+		return false;
+	int Error = ((const struct nlmsgerr*)NLMSG_DATA(pHeader))->error;
+	if (Error != 0)
+	{
+		errno = -Error;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "../SocketInfo.h"
+
+struct SSockDiagEntry
+{
+	SSockDiagEntry()
+	{
+		ProtocolType = 0;
+		LocalPort = 0;
+		RemotePort = 0;
+		State = 0;
+		Interface = 0;
+		Inode = 0;
+		Cookie = 0;
+		UserId = 0;
+
+		HasTcpInfo = false;
+		BytesSent = 0;
+		BytesReceived = 0;
+		SegmentsSent = 0;
+		SegmentsReceived = 0;
+		RoundTripTime = 0;
+		RoundTripTimeVar = 0;
+		Retransmissions = 0;
+		CongestionWindow = 0;
+	}
+
+	quint32			ProtocolType;
+	QHostAddress	LocalAddress;
+	quint16			LocalPort;
+	QHostAddress	RemoteAddress;
+	quint16			RemotePort;
+	quint32			State; // MIB_TCP_STATE
+	quint32			Interface;
+	quint64			Inode;
+	quint64			Cookie;
+	quint32			UserId;
+	QString			Path; // UNIX sockets only
+
+	// TCP sockets only, from INET_DIAG_INFO
+	bool			HasTcpInfo;
+	quint64			BytesSent; // acknowledged by the peer
+	quint64			BytesReceived;
+	quint32			SegmentsSent;
+	quint32			SegmentsReceived;
+	quint32			RoundTripTime; // in us
+	quint32			RoundTripTimeVar; // in us
+	quint32			Retransmissions;
+	quint32			CongestionWindow; // in segments
+};
+
+class CSockDiag
+{
+public:
+	CSockDiag();
+	~CSockDiag();
+
+	bool			Open();
+	bool			IsOpen() const	{ return m_Socket != -1; }
+
+	bool			DumpInet(int Family, int Protocol, QVector<SSockDiagEntry>& Entries);
+	bool			DumpUnix(QVector<SSockDiagEntry>& Entries);
+
+	bool			Destroy(const SSockDiagEntry& Entry);
+
+protected:
+	bool			Request(const void* pRequest, size_t Length);
+	bool			Receive(QVector<SSockDiagEntry>& Entries, quint32 ProtocolType);
+
+	void			ParseInet(const struct nlmsghdr* pHeader, quint32 ProtocolType, SSockDiagEntry& Entry);
+	void			ParseUnix(const struct nlmsghdr* pHeader, SSockDiagEntry& Entry);
+	void			ParseTcpInfo(const struct tcp_info* pInfo, size_t Size, SSockDiagEntry& Entry);
+
+	int				m_Socket;
+	QByteArray		m_Buffer;
+};
@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#include <string>
+#include <vector>
+
+// Syscall count and time of one update which reads the stat, statm, io and status files of every process,
+// once the way it was done before CProcFileCache, open, read until the end and close, and once with the
+// descriptors kept open between updates and read with a single pread, see the Makefile.
+// By default a synthetic tree with 20000 processes made from the fixtures is used, pass /proc to read the live processes:
+//	./ProcFileBench [processes|/proc] [descriptor budget]
+
+static const char* g_FileNames[] = { "stat", "statm", "io", "status" };
+static const int g_FileCount = 4;
+
+static unsigned long long g_Syscalls = 0;
+
+static std::string g_Root;
+static std::vector<unsigned long long> g_Pids;
+
+static double Now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int CountedOpen(unsigned long long Pid, int File)
+{
+	char Path[256];
+	snprintf(Path, sizeof(Path), "%s/%llu/%s", g_Root.c_str(), Pid, g_FileNames[File]);
+	g_Syscalls++;
+	return open(Path, O_RDONLY | O_CLOEXEC);
+}
+
+static void CountedClose(int fd)
+{
+	g_Syscalls++;
+	close(fd);
+}
+
+// the old way, read until read returns 0
+static void ReadOpenClose(unsigned long long Pid, int File, std::vector<char>& Buffer)
+{
+	int fd = CountedOpen(Pid, File);
+	if (fd == -1)
+		return;
+	for (;;)
+	{
+		g_Syscalls++;
+		if (read(fd, Buffer.data(), Buffer.size()) <= 0)
+			break;
+	}
+	CountedClose(fd);
+}
+
+// the way of CProcFileCache::Read, a short read means we got everything
+static void PRead(int fd, std::vector<char>& Buffer)
+{
+	size_t Length = 0;
+	for (;;)
+	{
+		g_Syscalls++;
+		ssize_t Read = pread(fd, Buffer.data() + Length, Buffer.size() - Length, Length);
+		if (Read < 0)
+			break;
+		Length += Read;
+		if (Length < Buffer.size())
+			break;
+		Buffer.resize(Buffer.size() * 2);
+	}
+}
+
+struct SCache
+{
+	SCache(size_t Count, int Budget) : Fds(Count * g_FileCount, -1), MaxOpen(Budget), OpenCount(0) {}
+	~SCache()
+	{
+		for (size_t i = 0; i < Fds.size(); i++)
+		{
+			if (Fds[i] >= 0)
+				close(Fds[i]);
+		}
+	}
+
+	std::vector<int>	Fds;
+	int					MaxOpen;
+	int					OpenCount;
+};
+
+// like CProcFileCache, once the budget is used up the remaining files are opened for each read
+static void ReadCached(SCache& Cache, size_t Index, int File, std::vector<char>& Buffer)
+{
+	int& fd = Cache.Fds[Index * g_FileCount + File];
+	if (fd == -1)
+	{
+		int NewFd = CountedOpen(g_Pids[Index], File);
+		if (NewFd == -1)
+			return;
+		if (Cache.OpenCount >= Cache.MaxOpen)
+		{
+			PRead(NewFd, Buffer);
+			CountedClose(NewFd);
+			return;
+		}
+		fd = NewFd;
+		Cache.OpenCount++;
+	}
+	PRead(fd, Buffer);
+}
+
+static int RaiseFdLimit(int Budget)
+{
+	// Note: like CProcFileCache::SetMaxOpen we want twice the budget, and use at most half of what we get
+	struct rlimit Limit;
+	if (getrlimit(RLIMIT_NOFILE, &Limit) != 0 || Limit.rlim_cur == RLIM_INFINITY)
+		return Budget;
+	rlim_t Wanted = (rlim_t)Budget * 2;
+	if (Limit.rlim_cur < Wanted)
+	{
+		Limit.rlim_cur = (Limit.rlim_max == RLIM_INFINITY || Limit.rlim_max > Wanted) ? Wanted : Limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &Limit);
+		getrlimit(RLIMIT_NOFILE, &Limit);
+	}
+	return Budget > (int)(Limit.rlim_cur / 2) ? (int)(Limit.rlim_cur / 2) : Budget;
+}
+
+static std::string LoadFixture(const char* Name)
+{
+	std::string Data;
+	std::string Path = std::string("fixtures/") + Name;
+	FILE* pFile = fopen(Path.c_str(), "rb");
+	if (!pFile)
+		return "0\n";
+	char Buffer[4096];
+	size_t Read;
+	while ((Read = fread(Buffer, 1, sizeof(Buffer), pFile)) > 0)
+		Data.append(Buffer, Read);
+	fclose(pFile);
+	return Data;
+}
+
+static bool MakeTree(int Count)
+{
+	char Template[] = "/tmp/procbench.XXXXXX";
+	if (!mkdtemp(Template))
+		return false;
+	g_Root = Template;
+
+	std::string Data[g_FileCount];
+	for (int File = 0; File < g_FileCount; File++)
+		Data[File] = LoadFixture(g_FileNames[File]);
+
+	char Path[256];
+	for (int i = 0; i < Count; i++)
+	{
+		unsigned long long Pid = 100 + i;
+		snprintf(Path, sizeof(Path), "%s/%llu", g_Root.c_str(), Pid);
+		if (mkdir(Path, 0755) != 0)
+			return false;
+		for (int File = 0; File < g_FileCount; File++)
+		{
+			snprintf(Path, sizeof(Path), "%s/%llu/%s", g_Root.c_str(), Pid, g_FileNames[File]);
+			FILE* pFile = fopen(Path, "wb");
+			if (!pFile)
+				return false;
+			fwrite(Data[File].data(), 1, Data[File].size(), pFile);
+			fclose(pFile);
+		}
+		g_Pids.push_back(Pid);
+	}
+	return true;
+}
+
+static int RemoveEntry(const char* pPath, const struct stat* pStat, int Flag, struct FTW* pFtw)
+{
+	return remove(pPath);
+}
+
+static void ListProc()
+{
+	g_Root = "/proc";
+	DIR* pDir = opendir("/proc");
+	if (!pDir)
+		return;
+	while (struct dirent* pEntry = readdir(pDir))
+	{
+		if (pEntry->d_name[0] >= '0' && pEntry->d_name[0] <= '9')
+			g_Pids.push_back(strtoull(pEntry->d_name, NULL, 10));
+	}
+	closedir(pDir);
+}
+
+static void Report(const char* pName, unsigned long long Syscalls, double Ms)
+{
+	printf("%-32s %10llu syscalls %8.2f per process %9.2f ms\n", pName, Syscalls, (double)Syscalls / g_Pids.size(), Ms);
+}
+
+int main(int argc, char* argv[])
+{
+	bool bLive = argc > 1 && strcmp(argv[1], "/proc") == 0;
+	int Count = (argc > 1 && !bLive) ? atoi(argv[1]) : 20000;
+	int Budget = argc > 2 ? atoi(argv[2]) : 65536; // the default of Options/LinuxProcFdCache
+	const int Ticks = 5;
+
+	if (bLive)
+		ListProc();
+	else if (!MakeTree(Count))
+	{
+		printf("can not create the synthetic tree\n");
+		return 1;
+	}
+
+	std::vector<char> Buffer(4096);
+	int MaxBudget = RaiseFdLimit((int)g_Pids.size() * g_FileCount);
+	Budget = Budget > MaxBudget ? MaxBudget : Budget;
+
+	printf("%zu processes from %s, %d updates each, descriptor budget %d and %d\n", g_Pids.size(), g_Root.c_str(), Ticks, Budget, MaxBudget);
+
+	// open, read and close on every update
+	unsigned long long Syscalls = g_Syscalls;
+	double Start = Now();
+	for (int Tick = 0; Tick < Ticks; Tick++)
+	{
+		for (size_t i = 0; i < g_Pids.size(); i++)
+		{
+			for (int File = 0; File < g_FileCount; File++)
+				ReadOpenClose(g_Pids[i], File, Buffer);
+		}
+	}
+	Report("open, read, close", (g_Syscalls - Syscalls) / Ticks, (Now() - Start) / Ticks);
+
+	// cached descriptors, the first update opens them, the following ones only pread
+	int Budgets[] = { Budget, MaxBudget };
+	for (int b = 0; b < 2; b++)
+	{
+		SCache Cache(g_Pids.size(), Budgets[b]);
+		for (int Tick = 0; Tick <= Ticks; Tick++)
+		{
+			if (Tick == 1) // the first update opens the files, measure only the following ones
+			{
+				Syscalls = g_Syscalls;
+				Start = Now();
+			}
+			for (size_t i = 0; i < g_Pids.size(); i++)
+			{
+				for (int File = 0; File < g_FileCount; File++)
+					ReadCached(Cache, i, File, Buffer);
+			}
+		}
+		char Name[64];
+		snprintf(Name, sizeof(Name), "pread, %d cached fds", Cache.OpenCount);
+		Report(Name, (g_Syscalls - Syscalls) / Ticks, (Now() - Start) / Ticks);
+	}
+
+	if (!bLive)
+		nftw(g_Root.c_str(), RemoveEntry, 64, FTW_DEPTH | FTW_PHYS);
+	return 0;
+}
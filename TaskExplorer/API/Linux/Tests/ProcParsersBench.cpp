@@ -0,0 +1,180 @@
+#include "stdafx.h"
+#include "../ProcParsers.h"
+
+#include <time.h>
+
+#include <string>
+
+// Time of the /proc parsers on the captured samples in fixtures/, see the Makefile.
+// For comparison stat is also parsed with sscanf, the way a libc based collector would read it.
+//	./ProcParsersBench [fixture dir] [iterations]
+
+static std::string g_FixtureDir;
+static int g_Iterations = 1000000;
+
+static volatile quint64 g_Sink; // keeps the compiler from dropping the parse results
+
+static double Now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000.0 + ts.tv_nsec;
+}
+
+static std::string Load(const char* Name)
+{
+	std::string Path = g_FixtureDir + "/" + Name;
+	std::string Data;
+	FILE* pFile = fopen(Path.c_str(), "rb");
+	if (!pFile)
+	{
+		printf("missing fixture %s\n", Path.c_str());
+		exit(1);
+	}
+	char Buffer[4096];
+	size_t Read;
+	while ((Read = fread(Buffer, 1, sizeof(Buffer), pFile)) > 0)
+		Data.append(Buffer, Read);
+	fclose(pFile);
+	return Data;
+}
+
+static void Report(const char* pName, const std::string& Data, double Start)
+{
+	double Ns = (Now() - Start) / g_Iterations;
+	printf("%-24s %6zu bytes %9.1f ns %9.1f MB/s\n", pName, Data.size(), Ns, Data.size() * 1000.0 / Ns);
+}
+
+static void BenchStat(const char* Name)
+{
+	std::string Data = Load(Name);
+	const char* pEnd = Data.data() + Data.size();
+	SProcStat Stat;
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		ParseProcStat(Data.data(), pEnd, Stat);
+		g_Sink += Stat.ResidentPages;
+	}
+	Report(Name, Data, Start);
+}
+
+static void BenchStatScanf()
+{
+	std::string Data = Load("stat"); // null terminated by std::string
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		const char* pPos = strrchr(Data.c_str(), ')');
+		if (!pPos)
+			continue;
+		char State;
+		long long ParentId, SessionId, Priority, Nice, NumThreads;
+		unsigned long long Flags, MinorFaults, MajorFaults, UserTime, KernelTime, StartTime, VirtualSize, ResidentPages;
+		sscanf(pPos + 2, "%c %lld %*d %lld %*d %*d %llu %llu %*u %llu %*u %llu %llu %*d %*d %lld %lld %lld %*d %llu %llu %llu",
+			&State, &ParentId, &SessionId, &Flags, &MinorFaults, &MajorFaults, &UserTime, &KernelTime,
+			&Priority, &Nice, &NumThreads, &StartTime, &VirtualSize, &ResidentPages);
+		g_Sink += ResidentPages;
+	}
+	Report("stat (sscanf)", Data, Start);
+}
+
+static void BenchStatm()
+{
+	std::string Data = Load("statm");
+	const char* pEnd = Data.data() + Data.size();
+	SProcStatm Statm;
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		ParseProcStatm(Data.data(), pEnd, Statm);
+		g_Sink += Statm.Resident;
+	}
+	Report("statm", Data, Start);
+}
+
+static void BenchIo()
+{
+	std::string Data = Load("io");
+	const char* pEnd = Data.data() + Data.size();
+	SProcIo Io;
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		ParseProcIo(Data.data(), pEnd, Io);
+		g_Sink += Io.ReadBytes;
+	}
+	Report("io", Data, Start);
+}
+
+static void BenchStatus(const char* Name)
+{
+	std::string Data = Load(Name);
+	const char* pEnd = Data.data() + Data.size();
+	SProcStatus Status;
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		ParseProcStatus(Data.data(), pEnd, Status);
+		g_Sink += Status.VoluntaryCtxtSwitches;
+	}
+	Report(Name, Data, Start);
+}
+
+static void BenchMemInfo()
+{
+	std::string Data = Load("meminfo");
+	const char* pEnd = Data.data() + Data.size();
+	static const char* const Keys[] = { "MemTotal:", "MemFree:", "MemAvailable:", "Cached:", "SwapTotal:", "SwapFree:" };
+	quint64 Values[6];
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		g_Sink += ParseKeyValues(Data.data(), pEnd, Keys, 6, Values);
+		g_Sink += Values[0];
+	}
+	Report("meminfo", Data, Start);
+}
+
+static void BenchNetDev()
+{
+	std::string Data = Load("net_dev");
+	const char* pEnd = Data.data() + Data.size();
+	double Start = Now();
+	for (int i = 0; i < g_Iterations; i++)
+	{
+		const char* pPos = Data.data();
+		for (int Header = 0; Header < 2 && pPos < pEnd; Header++)
+			pPos = NextLine(pPos, pEnd);
+		SProcNetDevEntry Entry;
+		while (pPos < pEnd)
+		{
+			if (ParseProcNetDevLine(pPos, pEnd, Entry))
+				g_Sink += Entry.ReceiveBytes;
+		}
+	}
+	Report("net_dev", Data, Start);
+}
+
+int main(int argc, char* argv[])
+{
+	g_FixtureDir = argc > 1 ? argv[1] : "fixtures";
+	if (argc > 2)
+		g_Iterations = atoi(argv[2]);
+	if (g_Iterations < 1)
+		g_Iterations = 1;
+
+	printf("%d iterations per sample\n", g_Iterations);
+
+	BenchStat("stat");
+	BenchStat("stat_tricky_name");
+	BenchStat("kthread_stat");
+	BenchStatScanf();
+	BenchStatm();
+	BenchIo();
+	BenchStatus("status");
+	BenchStatus("kthread_status");
+	BenchMemInfo();
+	BenchNetDev();
+	return 0;
+}
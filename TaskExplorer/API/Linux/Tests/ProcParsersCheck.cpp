@@ -0,0 +1,265 @@
+#include "stdafx.h"
+#include "../ProcParsers.h"
+
+#include <string>
+#include <vector>
+
+// Standalone check of the /proc parsers against captured samples, see the Makefile.
+// Besides the expected values, every sample is parsed at every truncated length and with random damage,
+// each time from an exactly sized heap buffer, so that the sanitizers catch any read past the range.
+
+static int g_Failed = 0;
+
+#define CHECK(x) do { if (!(x)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #x); g_Failed++; } } while (0)
+
+static std::string g_FixtureDir;
+
+static std::string Load(const char* Name)
+{
+	std::string Path = g_FixtureDir + "/" + Name;
+	std::string Data;
+	FILE* pFile = fopen(Path.c_str(), "rb");
+	if (!pFile)
+	{
+		printf("missing fixture %s\n", Path.c_str());
+		g_Failed++;
+		return Data;
+	}
+	char Buffer[4096];
+	size_t Read;
+	while ((Read = fread(Buffer, 1, sizeof(Buffer), pFile)) > 0)
+		Data.append(Buffer, Read);
+	fclose(pFile);
+	return Data;
+}
+
+static bool NameIs(const char* pName, int Length, const char* Expected)
+{
+	return Length == (int)strlen(Expected) && memcmp(pName, Expected, Length) == 0;
+}
+
+static void CheckStat()
+{
+	std::string Data = Load("stat");
+	SProcStat Stat;
+	CHECK(ParseProcStat(Data.data(), Data.data() + Data.size(), Stat));
+	CHECK(NameIs(Stat.pName, Stat.NameLength, "sleep"));
+	CHECK(Stat.State == 'S');
+	CHECK(Stat.ParentId == 7138);
+	CHECK(Stat.SessionId == 7138);
+	CHECK(Stat.Flags == 4194304);
+	CHECK(Stat.MinorFaults == 114);
+	CHECK(Stat.Priority == 20);
+	CHECK(Stat.Nice == 0);
+	CHECK(Stat.NumThreads == 1);
+	CHECK(Stat.StartTime == 497214);
+	CHECK(Stat.VirtualSize == 2560000);
+	CHECK(Stat.ResidentPages == 348);
+
+	Data = Load("kthread_stat");
+	CHECK(ParseProcStat(Data.data(), Data.data() + Data.size(), Stat));
+	CHECK(NameIs(Stat.pName, Stat.NameLength, "kthreadd"));
+	CHECK(Stat.ParentId == 0);
+	CHECK((Stat.Flags & 0x00200000) != 0); // PF_KTHREAD
+	CHECK(Stat.StartTime == 5);
+	CHECK(Stat.VirtualSize == 0);
+
+	// the name may contain spaces and brackets, only the last ')' ends it
+	Data = Load("stat_tricky_name");
+	CHECK(ParseProcStat(Data.data(), Data.data() + Data.size(), Stat));
+	CHECK(NameIs(Stat.pName, Stat.NameLength, "my ) proc (x)"));
+	CHECK(Stat.State == 'R');
+	CHECK(Stat.ParentId == 1);
+	CHECK(Stat.MajorFaults == 2);
+	CHECK(Stat.UserTime == 150);
+	CHECK(Stat.KernelTime == 75);
+	CHECK(Stat.Nice == -5);
+	CHECK(Stat.NumThreads == 4);
+	CHECK(Stat.StartTime == 12345);
+	CHECK(Stat.ResidentPages == 256);
+
+	Data = Load("stat_truncated");
+	CHECK(!ParseProcStat(Data.data(), Data.data() + Data.size(), Stat));
+}
+
+static void CheckStatm()
+{
+	std::string Data = Load("statm");
+	SProcStatm Statm;
+	CHECK(ParseProcStatm(Data.data(), Data.data() + Data.size(), Statm));
+	CHECK(Statm.Size == 625);
+	CHECK(Statm.Resident == 372);
+	CHECK(Statm.Shared == 348);
+	CHECK(Statm.Text == 5);
+	CHECK(Statm.Data == 89);
+
+	const char Short[] = "625 372 348";
+	CHECK(!ParseProcStatm(Short, Short + sizeof(Short) - 1, Statm));
+}
+
+static void CheckIo()
+{
+	std::string Data = Load("io");
+	SProcIo Io;
+	CHECK(ParseProcIo(Data.data(), Data.data() + Data.size(), Io));
+	CHECK(Io.ReadChars == 3980);
+	CHECK(Io.WriteChars == 0);
+	CHECK(Io.ReadCalls == 9);
+	CHECK(Io.WriteCalls == 0);
+	CHECK(Io.ReadBytes == 0);
+	CHECK(Io.WriteBytes == 0);
+}
+
+static void CheckStatus()
+{
+	std::string Data = Load("status");
+	SProcStatus Status;
+	CHECK(ParseProcStatus(Data.data(), Data.data() + Data.size(), Status));
+	CHECK(Status.VoluntaryCtxtSwitches == 1);
+	CHECK(Status.NonVoluntaryCtxtSwitches == 0);
+	CHECK(Status.SwapSize == 0);
+
+	// kernel threads have no VmSwap line
+	Data = Load("kthread_status");
+	CHECK(ParseProcStatus(Data.data(), Data.data() + Data.size(), Status));
+	CHECK(Status.VoluntaryCtxtSwitches == 56);
+	CHECK(Status.SwapSize == 0);
+}
+
+static void CheckKeyValues()
+{
+	std::string Data = Load("meminfo");
+	static const char* Keys[] = { "MemTotal", "MemAvailable", "SwapTotal", "Committed_AS", "NotThere", "Mem" };
+	quint64 Values[6];
+	memset(Values, 0, sizeof(Values));
+	quint64 Found = ParseKeyValues(Data.data(), Data.data() + Data.size(), Keys, 6, Values);
+	CHECK(Found == 0x0F); // a key must match entirely, "Mem" is not a prefix match of "MemTotal"
+	CHECK(Values[0] == 6158152);
+	CHECK(Values[1] == 5618244);
+	CHECK(Values[2] == 0);
+	CHECK(Values[3] == 339212);
+}
+
+static void CheckNetDev()
+{
+	std::string Data = Load("net_dev");
+	const char* pEnd = Data.data() + Data.size();
+	const char* pPos = NextLine(NextLine(Data.data(), pEnd), pEnd);
+
+	int Count = 0;
+	while (pPos < pEnd)
+	{
+		SProcNetDevEntry Entry;
+		if (!ParseProcNetDevLine(pPos, pEnd, Entry))
+			continue;
+		Count++;
+
+		if (NameIs(Entry.pName, Entry.NameLength, "lo"))
+		{
+			CHECK(Entry.ReceiveBytes == 172951488);
+			CHECK(Entry.ReceivePackets == 17265);
+			CHECK(Entry.SendBytes == 172951488);
+			CHECK(Entry.SendPackets == 17265);
+		}
+		else if (NameIs(Entry.pName, Entry.NameLength, "eth0"))
+		{
+			CHECK(Entry.ReceiveBytes == 1834);
+			CHECK(Entry.ReceivePackets == 27);
+			CHECK(Entry.SendBytes == 1662);
+			CHECK(Entry.SendPackets == 25);
+		}
+	}
+	CHECK(Count == 4);
+
+	// old kernels put no space between the colon and large counters
+	const char Line[] = "eth1:123456789 10 0 0 0 0 0 0 987654321 20 0 0 0 0 0 0\n";
+	pPos = Line;
+	SProcNetDevEntry Entry;
+	CHECK(ParseProcNetDevLine(pPos, Line + sizeof(Line) - 1, Entry));
+	CHECK(NameIs(Entry.pName, Entry.NameLength, "eth1"));
+	CHECK(Entry.ReceiveBytes == 123456789);
+	CHECK(Entry.SendBytes == 987654321);
+	CHECK(pPos == Line + sizeof(Line) - 1);
+}
+
+static void ParseAll(const char* pBegin, const char* pEnd)
+{
+	SProcStat Stat;
+	ParseProcStat(pBegin, pEnd, Stat);
+	SProcStatm Statm;
+	ParseProcStatm(pBegin, pEnd, Statm);
+	SProcIo Io;
+	ParseProcIo(pBegin, pEnd, Io);
+	SProcStatus Status;
+	ParseProcStatus(pBegin, pEnd, Status);
+
+	for (const char* pPos = pBegin; pPos < pEnd;)
+	{
+		SProcNetDevEntry Entry;
+		const char* pLast = pPos;
+		ParseProcNetDevLine(pPos, pEnd, Entry);
+		if (pPos <= pLast || pPos > pEnd)
+		{
+			printf("ParseProcNetDevLine did not advance properly\n");
+			g_Failed++;
+			break;
+		}
+	}
+}
+
+static void Fuzz()
+{
+	static const char* Fixtures[] = { "stat", "kthread_stat", "stat_tricky_name", "stat_truncated", "statm", "io", "status", "kthread_status", "meminfo", "net_dev" };
+	static const char Interesting[] = { '(', ')', ' ', '\t', '\n', ':', '-', '0', '9', '\0' };
+
+	unsigned int Seed = 1;
+	for (size_t f = 0; f < sizeof(Fixtures) / sizeof(Fixtures[0]); f++)
+	{
+		std::string Data = Load(Fixtures[f]);
+
+		// every prefix, as a read may return a partial file
+		for (size_t Length = 0; Length <= Data.size(); Length++)
+		{
+			std::vector<char> Buffer(Data.begin(), Data.begin() + Length);
+			ParseAll(Buffer.data(), Buffer.data() + Buffer.size());
+		}
+
+		// random damage
+		for (int i = 0; i < 2000; i++)
+		{
+			std::vector<char> Buffer(Data.begin(), Data.end());
+			int Changes = 1 + rand_r(&Seed) % 8;
+			for (int j = 0; j < Changes && !Buffer.empty(); j++)
+			{
+				size_t Pos = rand_r(&Seed) % Buffer.size();
+				if (rand_r(&Seed) % 2)
+					Buffer[Pos] = Interesting[rand_r(&Seed) % sizeof(Interesting)];
+				else
+					Buffer[Pos] = (char)rand_r(&Seed);
+			}
+			Buffer.resize(rand_r(&Seed) % (Buffer.size() + 1));
+			ParseAll(Buffer.data(), Buffer.data() + Buffer.size());
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	g_FixtureDir = argc > 1 ? argv[1] : "fixtures";
+
+	CheckStat();
+	CheckStatm();
+	CheckIo();
+	CheckStatus();
+	CheckKeyValues();
+	CheckNetDev();
+	Fuzz();
+
+	if (g_Failed)
+	{
+		printf("%d checks failed\n", g_Failed);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <QReadWriteLock>
+
+#include "../../SeqLock.h"
+
+// Contention between one writer publishing a sample and N readers taking copies of it,
+// once through CSeqLock and once with the sample guarded by a QReadWriteLock like before, see the Makefile.
+//	./SeqLockBench [readers] [milliseconds] [writer pause in us, 0 stores back to back]
+
+struct SSample // about the size of SProcessStatsSample
+{
+	quint64 Values[32];
+};
+
+static void Fill(SSample& Sample, quint64 Value)
+{
+	for (int i = 0; i < 32; i++)
+		Sample.Values[i] = Value;
+}
+
+static bool IsTorn(const SSample& Sample)
+{
+	for (int i = 1; i < 32; i++)
+	{
+		if (Sample.Values[i] != Sample.Values[0])
+			return true;
+	}
+	return false;
+}
+
+class CLockedSample
+{
+public:
+	CLockedSample()		{ Fill(m_Value, 0); }
+
+	void Store(const SSample& Value)
+	{
+		QWriteLocker Locker(&m_Mutex);
+		m_Value = Value;
+	}
+
+	SSample Load() const
+	{
+		QReadLocker Locker(&m_Mutex);
+		return m_Value;
+	}
+
+private:
+	mutable QReadWriteLock	m_Mutex;
+	SSample					m_Value;
+};
+
+struct SResult
+{
+	quint64 Stores;
+	quint64 Loads;
+	quint64 Torn;
+	quint64 MaxLoadNs;
+};
+
+template <class T>
+static SResult Run(int Readers, int Milliseconds, int PauseUs)
+{
+	T Published;
+	std::atomic<bool> bStop(false);
+	std::atomic<quint64> Loads(0);
+	std::atomic<quint64> Torn(0);
+	std::atomic<quint64> MaxLoadNs(0);
+	quint64 Stores = 0;
+
+	std::vector<std::thread> Threads;
+	for (int i = 0; i < Readers; i++)
+	{
+		Threads.push_back(std::thread([&]() {
+			quint64 Count = 0;
+			quint64 TornCount = 0;
+			quint64 MaxNs = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+				SSample Sample = Published.Load();
+				quint64 Ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+				if (Ns > MaxNs)
+					MaxNs = Ns;
+				if (IsTorn(Sample))
+					TornCount++;
+				Count++;
+			}
+			Loads += Count;
+			Torn += TornCount;
+			quint64 Max = MaxLoadNs.load();
+			while (MaxNs > Max && !MaxLoadNs.compare_exchange_weak(Max, MaxNs));
+		}));
+	}
+
+	std::thread Writer([&]() {
+		SSample Sample;
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			Fill(Sample, ++Stores);
+			Published.Store(Sample);
+			if (PauseUs > 0)
+				std::this_thread::sleep_for(std::chrono::microseconds(PauseUs));
+		}
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
+	bStop = true;
+	Writer.join();
+	for (size_t i = 0; i < Threads.size(); i++)
+		Threads[i].join();
+
+	SResult Result = { Stores, Loads.load(), Torn.load(), MaxLoadNs.load() };
+	return Result;
+}
+
+static void Report(const char* pName, int Readers, int Milliseconds, const SResult& Result)
+{
+	printf("%-16s %2d readers %12.0f stores/s %14.0f loads/s %8llu us max load %llu torn\n", pName, Readers,
+		Result.Stores * 1000.0 / Milliseconds, Result.Loads * 1000.0 / Milliseconds, Result.MaxLoadNs / 1000, Result.Torn);
+}
+
+int main(int argc, char* argv[])
+{
+	int MaxReaders = argc > 1 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+	int Milliseconds = argc > 2 ? atoi(argv[2]) : 1000;
+	int PauseUs = argc > 3 ? atoi(argv[3]) : 0;
+	if (MaxReaders < 1)
+		MaxReaders = 1;
+
+	int Failed = 0;
+	for (int Readers = 1; Readers <= MaxReaders; Readers *= 2)
+	{
+		SResult Seq = Run<CSeqLock<SSample> >(Readers, Milliseconds, PauseUs);
+		Report("CSeqLock", Readers, Milliseconds, Seq);
+		SResult Locked = Run<CLockedSample>(Readers, Milliseconds, PauseUs);
+		Report("QReadWriteLock", Readers, Milliseconds, Locked);
+		if (Seq.Torn || Locked.Torn)
+			Failed++;
+	}
+
+	if (Failed)
+		printf("torn reads seen\n");
+	return Failed ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <QtWidgets>
+
+#include "../../../../MiscHelpers/Common/TreeViewEx.h"
+
+// Time of sorting 10000 and 50000 rows by a numeric and by a text column, once through QSortFilterProxyModel::lessThan,
+// which gets both values with data() and compares the variants, the way the proxy sorted before SortLessThan,
+// and once with CompareSortKeys on the values as the models of MiscHelpers store them, see the Makefile.
+//	./SortKeysBench [rows ...]
+
+// Note: never instantiated, it only makes the protected helpers of the model reachable
+struct SSortKeys : public QAbstractItemModelEx
+{
+	using QAbstractItemModelEx::CompareSortKeys;
+	using QAbstractItemModelEx::SCellValue;
+};
+
+class CProxyLessThan : public QSortFilterProxyModel
+{
+public:
+	bool LessThan(const QModelIndex& left, const QModelIndex& right) const { return QSortFilterProxyModel::lessThan(left, right); }
+};
+
+static double Now()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int Bench(int Rows)
+{
+	enum { eNumber = 0, eText, eCount };
+
+	QStandardItemModel Model(Rows, eCount);
+	std::vector<std::vector<SSortKeys::SCellValue> > Values(Rows, std::vector<SSortKeys::SCellValue>(eCount));
+	for (int i = 0; i < Rows; i++)
+	{
+		// a working set like size, with many equal values, and a process like name
+		quint64 Number = (quint64)(qrand() % (Rows / 4 + 1)) * 4096;
+		QString Text = QString("process_%1.exe").arg(qrand() % Rows);
+
+		Model.setData(Model.index(i, eNumber), Number, Qt::EditRole);
+		Model.setData(Model.index(i, eText), Text, Qt::EditRole);
+
+		Values[i][eNumber].SetNumber(Number);
+		Values[i][eText].Raw = Text;
+	}
+
+	CProxyLessThan Proxy;
+	Proxy.setSourceModel(&Model);
+	Proxy.setSortRole(Qt::EditRole);
+
+	int Failed = 0;
+	for (int Column = 0; Column < eCount; Column++)
+	{
+		std::vector<int> ByProxy(Rows);
+		std::vector<int> ByKeys(Rows);
+		for (int i = 0; i < Rows; i++)
+			ByProxy[i] = ByKeys[i] = i;
+
+		double Start = Now();
+		std::stable_sort(ByProxy.begin(), ByProxy.end(), [&](int Left, int Right) {
+			return Proxy.LessThan(Model.index(Left, Column), Model.index(Right, Column));
+		});
+		double ProxyMs = Now() - Start;
+
+		Start = Now();
+		std::stable_sort(ByKeys.begin(), ByKeys.end(), [&](int Left, int Right) {
+			bool bLess = false;
+			if (!SSortKeys::CompareSortKeys(Values[Left][Column].Raw, Values[Right][Column].Raw, Qt::CaseSensitive, bLess))
+				Q_ASSERT(0);
+			return bLess;
+		});
+		double KeysMs = Now() - Start;
+
+		// Note: stable sorts with the same order give the same permutation
+		bool bSame = ByProxy == ByKeys;
+		if (!bSame)
+			Failed++;
+
+		printf("%6d rows %-7s lessThan %8.2f ms CompareSortKeys %8.2f ms %5.1fx %s\n", Rows, Column == eNumber ? "number" : "text",
+			ProxyMs, KeysMs, KeysMs > 0 ? ProxyMs / KeysMs : 0.0, bSame ? "same order" : "DIFFERENT ORDER");
+	}
+	return Failed;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication App(argc, argv);
+	qsrand(1);
+
+	int Failed = 0;
+	if (argc > 1)
+	{
+		for (int i = 1; i < argc; i++)
+			Failed += Bench(atoi(argv[i]));
+	}
+	else
+	{
+		Failed += Bench(10000);
+		Failed += Bench(50000);
+	}
+	return Failed ? 1 : 0;
+}
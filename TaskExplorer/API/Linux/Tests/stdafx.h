@@ -0,0 +1,11 @@
+#pragma once
+
+// Minimal replacement of the precompiled header, so that ProcParsers.cpp can be checked without Qt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef unsigned long long quint64;
+typedef long long qint64;
+typedef unsigned int quint32;
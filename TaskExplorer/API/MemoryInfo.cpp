@@ -2,7 +2,7 @@
 #include "MemoryInfo.h"
 
 
-CMemoryInfo::CMemoryInfo(QObject *parent) : CAbstractInfoEx(parent)
+CMemoryInfo::CMemoryInfo()
 {
 	m_ProcessId = 0;
 
@@ -5,16 +5,14 @@
 
 class CMemoryInfo: public CAbstractInfoEx
 {
-	Q_OBJECT
-
 public:
-	CMemoryInfo(QObject *parent = nullptr);
+	CMemoryInfo();
 	virtual ~CMemoryInfo();
 
 	virtual quint64 GetProcessId() const			{ QReadLocker Locker(&m_Mutex); return m_ProcessId; }
 
 	virtual quint64 GetBaseAddress() const			{ QReadLocker Locker(&m_Mutex); return m_BaseAddress; }
-	virtual quint64 GetAllocationBase() const		{ QReadLocker Locker(&m_Mutex); return m_AllocationBaseItem.isNull() ? 0 : m_AllocationBaseItem.staticCast<CMemoryInfo>()->GetBaseAddress(); }
+	virtual quint64 GetAllocationBase() const		{ QReadLocker Locker(&m_Mutex); return m_AllocationBaseItem.isNull() ? 0 : m_AllocationBaseItem->GetBaseAddress(); }
 	virtual bool IsAllocationBase() const;
 	virtual QString GetTypeString() const = 0;
 	virtual quint64 GetRegionSize() const			{ QReadLocker Locker(&m_Mutex); return m_RegionSize; }
@@ -68,7 +66,7 @@ protected:
     quint64				m_ShareableWorkingSet;
     quint64				m_LockedWorkingSet;
 
-	QSharedPointer<QObject>	m_AllocationBaseItem;
+	QSharedPointer<CMemoryInfo> m_AllocationBaseItem;
 };
 
 typedef QSharedPointer<CMemoryInfo> CMemoryPtr;
@@ -1,6 +1,8 @@
 #pragma once 
 #include <qobject.h>
+#include <atomic>
 #include "../../MiscHelpers/Common/Common.h"
+#include "SeqLock.h"
 
 template <class T>
 struct SRingBuffer
@@ -253,6 +255,54 @@ struct SSmoother
 	quint64			TotalValue;
 };
 
+// Flat copies of the current values of the stats below, they are trivially copyable
+// and are taken by the GUI in one go instead of copying the stats with their rate buffers
+
+struct SNetSample
+{
+	quint64			ReceiveCount;
+	quint64			ReceiveRaw;
+	quint64			SendCount;
+	quint64			SendRaw;
+
+	quint64			ReceiveDelta;
+	quint64			ReceiveRawDelta;
+	quint64			SendDelta;
+	quint64			SendRawDelta;
+
+	quint64			ReceiveRate;
+	quint64			SendRate;
+};
+
+struct SIOSample
+{
+	quint64			ReadCount;
+	quint64			ReadRaw;
+	quint64			WriteCount;
+	quint64			WriteRaw;
+	quint64			OtherCount;
+	quint64			OtherRaw;
+
+	quint64			ReadDelta;
+	quint64			ReadRawDelta;
+	quint64			WriteDelta;
+	quint64			WriteRawDelta;
+	quint64			OtherDelta;
+	quint64			OtherRawDelta;
+
+	quint64			ReadRate;
+	quint64			WriteRate;
+	quint64			OtherRate;
+};
+
+struct SProcSample
+{
+	SNetSample		Net;
+	SNetSample		Lan;
+	SIOSample		Disk;
+	SIOSample		Io;
+};
+
 struct SNetStats
 {
 	SNetStats()
@@ -293,6 +343,20 @@ struct SNetStats
 		SendRate.Update(Interval, SendRawDelta.Delta);
 	}
 
+	void GetSample(SNetSample& Sample) const
+	{
+		Sample.ReceiveCount = ReceiveCount;
+		Sample.ReceiveRaw = ReceiveRaw;
+		Sample.SendCount = SendCount;
+		Sample.SendRaw = SendRaw;
+		Sample.ReceiveDelta = ReceiveDelta.Delta;
+		Sample.ReceiveRawDelta = ReceiveRawDelta.Delta;
+		Sample.SendDelta = SendDelta.Delta;
+		Sample.SendRawDelta = SendRawDelta.Delta;
+		Sample.ReceiveRate = ReceiveRate.Get();
+		Sample.SendRate = SendRate.Get();
+	}
+
 	quint64			ReceiveCount;
 	quint64			ReceiveRaw;
 	quint64			SendCount;
@@ -347,6 +411,24 @@ struct SIOStats
 		WriteRate.Update(Interval, WriteRawDelta.Delta);
 	}
 
+	void GetSample(SIOSample& Sample) const
+	{
+		Sample.ReadCount = ReadCount;
+		Sample.ReadRaw = ReadRaw;
+		Sample.WriteCount = WriteCount;
+		Sample.WriteRaw = WriteRaw;
+		Sample.ReadDelta = ReadDelta.Delta;
+		Sample.ReadRawDelta = ReadRawDelta.Delta;
+		Sample.WriteDelta = WriteDelta.Delta;
+		Sample.WriteRawDelta = WriteRawDelta.Delta;
+		Sample.ReadRate = ReadRate.Get();
+		Sample.WriteRate = WriteRate.Get();
+
+		Sample.OtherCount = Sample.OtherRaw = 0;
+		Sample.OtherDelta = Sample.OtherRawDelta = 0;
+		Sample.OtherRate = 0;
+	}
+
 	quint64			ReadCount;
 	quint64			ReadRaw;
 	quint64			WriteCount;
@@ -383,6 +465,16 @@ struct SIOStatsEx: SIOStats
 		OtherRate.Update(Interval, OtherRawDelta.Delta);
 	}
 
+	void GetSample(SIOSample& Sample) const
+	{
+		SIOStats::GetSample(Sample);
+		Sample.OtherCount = OtherCount;
+		Sample.OtherRaw = OtherRaw;
+		Sample.OtherDelta = OtherDelta.Delta;
+		Sample.OtherRawDelta = OtherRawDelta.Delta;
+		Sample.OtherRate = OtherRate.Get();
+	}
+
 	quint64			OtherCount;
 	quint64			OtherRaw;
 
@@ -436,6 +528,14 @@ struct SProcStats
 		return time_ms;
 	}
 
+	void GetSample(SProcSample& Sample) const
+	{
+		Net.GetSample(Sample.Net);
+		Lan.GetSample(Sample.Lan);
+		Disk.GetSample(Sample.Disk);
+		Io.GetSample(Sample.Io);
+	}
+
 	quint64		LastStatUpdate;
 
 	SNetStats	Net;
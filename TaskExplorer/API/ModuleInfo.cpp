@@ -1,12 +1,10 @@
 #include "stdafx.h"
 #include "ModuleInfo.h"
+#include "IconCache.h"
 
 
-CModuleInfo::CModuleInfo(QObject *parent) : CAbstractInfo(parent)
+CModuleInfo::CModuleInfo()
 {
-	m_FileSize = 0;
-	m_ModificationTime = 0;
-
 	m_BaseAddress = NULL;
 	m_Size = 0;
 	m_ParentBaseAddress = 0;
@@ -17,3 +15,94 @@ CModuleInfo::CModuleInfo(QObject *parent) : CAbstractInfo(parent)
 CModuleInfo::~CModuleInfo()
 {
 }
+
+QPixmap CModuleInfo::GetFileIcon(bool bLarge) const
+{
+	CModuleImagePtr pImage = GetImage();
+	if (!pImage)
+		return QPixmap();
+
+	QPixmap Icon = CIconCache::Instance()->GetIcon(pImage->GetFileName(), pImage->GetModificationTime(), bLarge);
+	if (Icon.isNull() && bLarge) // not all files have a large icon
+		Icon = CIconCache::Instance()->GetIcon(pImage->GetFileName(), pImage->GetModificationTime(), false);
+	return Icon;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// CModuleImage
+
+struct SModuleImageKey
+{
+	SModuleImageKey(const QString& FileName, quint64 FileSize, quint64 ModificationTime)
+		: FileName(FileName), FileSize(FileSize), ModificationTime(ModificationTime) {}
+
+	bool operator==(const SModuleImageKey& Other) const { 
+		return FileSize == Other.FileSize && ModificationTime == Other.ModificationTime && FileName == Other.FileName; 
+	}
+
+	QString			FileName;
+	quint64			FileSize;
+	quint64			ModificationTime;
+};
+
+static uint qHash(const SModuleImageKey& Key, uint Seed = 0)
+{
+	return qHash(Key.FileName, Seed) ^ qHash(Key.ModificationTime, Seed);
+}
+
+// Note: the cache holds only weak references, a record is dropped when the last module using it is gone
+struct SModuleImageCache
+{
+	QMutex												Mutex;
+	QHash<SModuleImageKey, QWeakPointer<CModuleImage> >	Images;
+};
+
+static SModuleImageCache& ModuleImageCache()
+{
+	// Note: this is never freed, modules may still be released after the static destructors ran
+	static SModuleImageCache* pCache = new SModuleImageCache();
+	return *pCache;
+}
+
+CModuleImage::CModuleImage(const QString& FileName, quint64 FileSize, quint64 ModificationTime)
+{
+	m_FileName = FileName;
+	m_FileSize = FileSize;
+	m_ModificationTime = ModificationTime;
+}
+
+CModuleImage::~CModuleImage()
+{
+}
+
+QSharedPointer<CModuleImage> CModuleImage::Find(const QString& FileName, quint64 FileSize, quint64 ModificationTime, bool* bNew, 
+	CModuleImage* (*New)(const QString& FileName, quint64 FileSize, quint64 ModificationTime))
+{
+	SModuleImageKey Key(FileName, FileSize, ModificationTime);
+
+	SModuleImageCache& Cache = ModuleImageCache();
+	QMutexLocker Locker(&Cache.Mutex);
+	QWeakPointer<CModuleImage>& pEntry = Cache.Images[Key];
+	QSharedPointer<CModuleImage> pImage = pEntry.toStrongRef();
+	if (bNew)
+		*bNew = pImage.isNull();
+	if (pImage.isNull())
+	{
+		pImage = QSharedPointer<CModuleImage>(New(FileName, FileSize, ModificationTime), &CModuleImage::Release);
+		pEntry = pImage;
+	}
+	return pImage;
+}
+
+void CModuleImage::Release(CModuleImage* pImage)
+{
+	SModuleImageCache& Cache = ModuleImageCache();
+	QMutexLocker Locker(&Cache.Mutex);
+	QHash<SModuleImageKey, QWeakPointer<CModuleImage> >::iterator I = Cache.Images.find(SModuleImageKey(pImage->m_FileName, pImage->m_FileSize, pImage->m_ModificationTime));
+	// Note: the entry may already point to a new record created after our last reference was gone
+	if (I != Cache.Images.end() && I.value().isNull())
+		Cache.Images.erase(I);
+	Locker.unlock();
+
+	delete pImage;
+}
@@ -4,19 +4,60 @@
 #include "../../MiscHelpers/Common/FlexError.h"
 
 
-class CModuleInfo: public CAbstractInfo
+// The data of a module which depends only on its image file, the same library is mapped into many processes,
+// so it is kept once per file version and referenced by every module entry, instead of being loaded for each of them.
+class CModuleImage
 {
-	Q_OBJECT
+public:
+	CModuleImage(const QString& FileName, quint64 FileSize, quint64 ModificationTime);
+	virtual ~CModuleImage();
+
+	// Returns the shared record for the given file version, if there is none yet a new T is created and bNew is set
+	template <class T>
+	static QSharedPointer<T> Find(const QString& FileName, quint64 FileSize, quint64 ModificationTime, bool* bNew = NULL)
+	{
+		return Find(FileName, FileSize, ModificationTime, bNew, [](const QString& FileName, quint64 FileSize, quint64 ModificationTime) -> CModuleImage* {
+			return new T(FileName, FileSize, ModificationTime);
+		}).template staticCast<T>();
+	}
+
+	QString GetFileName() const								{ return m_FileName; }
+	quint64 GetFileSize() const								{ return m_FileSize; }
+	quint64 GetModificationTime() const						{ return m_ModificationTime; }
+
+	virtual void SetFileInfos(const QMap<QString, QString>&	FileDetails) { QWriteLocker Locker(&m_Mutex); m_FileDetails = FileDetails; }
+	virtual QString GetFileInfo(const QString& Name) const	{ QReadLocker Locker(&m_Mutex); return m_FileDetails.value(Name); }
+
+protected:
+	static QSharedPointer<CModuleImage> Find(const QString& FileName, quint64 FileSize, quint64 ModificationTime, bool* bNew, 
+		CModuleImage* (*New)(const QString& FileName, quint64 FileSize, quint64 ModificationTime));
+	static void Release(CModuleImage* pImage);
+
+	// the key, a changed file gets a new record
+	QString						m_FileName;
+	quint64						m_FileSize;
+	quint64						m_ModificationTime;
 
+	mutable QReadWriteLock		m_Mutex;
+
+	QMap<QString, QString>		m_FileDetails;
+};
+
+typedef QSharedPointer<CModuleImage> CModuleImagePtr;
+
+
+// Note: the async image data is delivered to a weak reference, see CWinModule::InitAsyncData
+class CModuleInfo: public CAbstractInfo, public QEnableSharedFromThis<CModuleInfo>
+{
 public:
-	CModuleInfo(QObject *parent = nullptr);
+	CModuleInfo();
 	virtual ~CModuleInfo();
 
 	virtual void SetFileName(const QString& FileName)		{ QWriteLocker Locker(&m_Mutex); m_FileName = FileName; }
 	virtual QString GetFileName() const						{ QReadLocker Locker(&m_Mutex); return m_FileName; }
 
-	virtual quint64 GetFileSize() const						{ QReadLocker Locker(&m_Mutex); return m_FileSize; }
-	virtual quint64 GetModificationTime() const				{ QReadLocker Locker(&m_Mutex); return m_ModificationTime; }
+	virtual quint64 GetFileSize() const						{ CModuleImagePtr pImage = GetImage(); return pImage ? pImage->GetFileSize() : 0; }
+	virtual quint64 GetModificationTime() const				{ CModuleImagePtr pImage = GetImage(); return pImage ? pImage->GetModificationTime() : 0; }
 
 	virtual QString GetName() const							{ QReadLocker Locker(&m_Mutex); return m_ModuleName; }
 
@@ -31,11 +72,9 @@ public:
 	virtual void SetLoaded(bool bSet)						{ QWriteLocker Locker(&m_Mutex); m_IsLoaded = bSet; }
 	virtual bool IsLoaded() const							{ QReadLocker Locker(&m_Mutex); return m_IsLoaded; }
 
-	virtual void SetFileInfos(const QMap<QString, QString>&	FileDetails) { QWriteLocker Locker(&m_Mutex); m_FileDetails = FileDetails; }
-	virtual QString GetFileInfo(const QString& Name) const	{ QReadLocker Locker(&m_Mutex); return m_FileDetails[Name]; }
-
-	virtual void SetFileIcon(const QPixmap& SmallIcon, const QPixmap& LargeIcon = QPixmap()) { QWriteLocker Locker(&m_Mutex); m_SmallIcon = SmallIcon;  m_LargeIcon = LargeIcon; }
-	virtual QPixmap GetFileIcon(bool bLarge = false) const	{ QReadLocker Locker(&m_Mutex); return (bLarge && !m_LargeIcon.isNull()) ? m_LargeIcon : m_SmallIcon; }
+	virtual CModuleImagePtr GetImage() const				{ QReadLocker Locker(&m_Mutex); return m_pImage; }
+	virtual QString GetFileInfo(const QString& Name) const	{ CModuleImagePtr pImage = GetImage(); return pImage ? pImage->GetFileInfo(Name) : QString(); }
+	virtual QPixmap GetFileIcon(bool bLarge = false) const; // gui thread only
 
 	virtual QSharedPointer<QObject>	GetProcess() const		{ QReadLocker Locker(&m_Mutex); return m_pProcess; }
 
@@ -45,8 +84,7 @@ protected:
 	friend class CWinModuleFinder;
 
 	QString						m_FileName;
-	quint64						m_FileSize;
-	quint64						m_ModificationTime;
+	CModuleImagePtr				m_pImage;
 
 	QString						m_ModuleName;
 	quint64						m_BaseAddress;
@@ -55,11 +93,6 @@ protected:
 	bool						m_IsFirst;
 	bool						m_IsLoaded;
 
-	QMap<QString, QString>		m_FileDetails;
-
-	QPixmap						m_SmallIcon;
-	QPixmap						m_LargeIcon;
-
 	QSharedPointer<QObject>		m_pProcess;
 };
 
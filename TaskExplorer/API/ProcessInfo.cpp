@@ -27,12 +27,111 @@ CProcessInfo::CProcessInfo(QObject *parent) : CAbstractTask(parent)
 	m_NetworkUsageFlags = 0;
 
 	m_DebugMessageCount = 0;
+
+	m_PendingDirty = eProcessAll;
+	m_DirtyFields = eProcessAll;
+	memset(&m_CommittedSample, 0, sizeof(m_CommittedSample));
 }
 
 CProcessInfo::~CProcessInfo()
 {
 }
 
+SProcessSample CProcessInfo::GetSnapshot() const
+{
+	SProcessSample Sample;
+
+	QReadLocker Locker(&m_Mutex);
+	Sample.ProcessId = m_ProcessId;
+	Sample.ParentId = m_ParentProcessId;
+	Sample.CreateTimeStamp = m_CreateTimeStamp;
+
+	Sample.NumberOfThreads = m_NumberOfThreads;
+	Sample.NumberOfHandles = m_NumberOfHandles;
+	Sample.PeakNumberOfThreads = m_PeakNumberOfThreads;
+
+	Sample.PeakPrivateBytes = m_PeakPagefileUsage;
+	Sample.WorkingSetSize = m_WorkingSetSize;
+	Sample.PeakWorkingSetSize = m_PeakWorkingSetSize;
+	Sample.PrivateWorkingSetSize = m_WorkingSetPrivateSize;
+	Sample.VirtualSize = m_VirtualSize;
+	Sample.PeakVirtualSize = m_PeakVirtualSize;
+
+	Sample.Priority = m_Priority;
+	Sample.BasePriority = m_BasePriority;
+	Sample.PagePriority = m_PagePriority;
+	Sample.IOPriority = m_IOPriority;
+	Locker.unlock();
+
+	SProcessStatsSample StatsSample = m_StatsSample.Load();
+	Sample.Cpu = StatsSample.Cpu;
+	Sample.Stats = StatsSample.Stats;
+	Sample.NetworkUsageFlags = StatsSample.NetworkUsageFlags;
+	return Sample;
+}
+
+void CProcessInfo::PublishStats()
+{
+	SProcessStatsSample StatsSample;
+	m_CpuStats.GetSample(StatsSample.Cpu);
+	m_Stats.GetSample(StatsSample.Stats);
+	StatsSample.NetworkUsageFlags = m_NetworkUsageFlags;
+	m_StatsSample.Store(StatsSample);
+}
+
+static bool TaskSampleChanged(const STaskSampleEx& New, const STaskSampleEx& Old)
+{
+	// Note: the deltas must be compared as well, they drop to 0 when the values stop changing
+	return New.CpuUsage != Old.CpuUsage || New.CpuKernelUsage != Old.CpuKernelUsage || New.CpuUserUsage != Old.CpuUserUsage
+		|| New.CpuKernelTime != Old.CpuKernelTime || New.CpuKernelTimeDelta != Old.CpuKernelTimeDelta
+		|| New.CpuUserTime != Old.CpuUserTime || New.CpuUserTimeDelta != Old.CpuUserTimeDelta
+		|| New.Cycles != Old.Cycles || New.CyclesDelta != Old.CyclesDelta
+		|| New.ContextSwitches != Old.ContextSwitches || New.ContextSwitchesDelta != Old.ContextSwitchesDelta
+		|| New.PageFaults != Old.PageFaults || New.PageFaultsDelta != Old.PageFaultsDelta
+		|| New.HardFaults != Old.HardFaults || New.HardFaultsDelta != Old.HardFaultsDelta
+		|| New.PrivateBytes != Old.PrivateBytes || New.PrivateBytesDelta != Old.PrivateBytesDelta;
+}
+
+const SProcessSample& CProcessInfo::CommitDirtyFields()
+{
+	SProcessSample Sample = GetSnapshot();
+	quint32 Fields = m_PendingDirty.fetchAndStoreOrdered(0);
+
+	if (TaskSampleChanged(Sample.Cpu, m_CommittedSample.Cpu))
+		Fields |= eProcessCpu;
+
+	// Note: SProcSample consists of quint64 only, so there is no padding to compare
+	if (memcmp(&Sample.Stats, &m_CommittedSample.Stats, sizeof(SProcSample)) != 0)
+		Fields |= eProcessIo;
+
+	if (Sample.PeakPrivateBytes != m_CommittedSample.PeakPrivateBytes || Sample.WorkingSetSize != m_CommittedSample.WorkingSetSize
+	 || Sample.PeakWorkingSetSize != m_CommittedSample.PeakWorkingSetSize || Sample.PrivateWorkingSetSize != m_CommittedSample.PrivateWorkingSetSize
+	 || Sample.VirtualSize != m_CommittedSample.VirtualSize || Sample.PeakVirtualSize != m_CommittedSample.PeakVirtualSize)
+		Fields |= eProcessMemory;
+
+	if (Sample.NumberOfThreads != m_CommittedSample.NumberOfThreads || Sample.NumberOfHandles != m_CommittedSample.NumberOfHandles
+	 || Sample.PeakNumberOfThreads != m_CommittedSample.PeakNumberOfThreads)
+		Fields |= eProcessCounts;
+
+	if (Sample.Priority != m_CommittedSample.Priority || Sample.BasePriority != m_CommittedSample.BasePriority
+	 || Sample.PagePriority != m_CommittedSample.PagePriority || Sample.IOPriority != m_CommittedSample.IOPriority
+	 || Sample.NetworkUsageFlags != m_CommittedSample.NetworkUsageFlags)
+		Fields |= eProcessState;
+
+	m_CommittedSample = Sample;
+	m_DirtyFields = Fields;
+	return m_CommittedSample;
+}
+
+void CProcessInfo::SetNetworkUsageFlag(quint64 uFlag)
+{
+	QWriteLocker Locker(&m_StatsMutex);
+	if ((m_NetworkUsageFlags & uFlag) == uFlag)
+		return;
+	m_NetworkUsageFlags |= uFlag;
+	PublishStats();
+}
+
 QString CProcessInfo::GetNetworkUsageString() const
 {
 	QReadLocker Locker(&m_StatsMutex);
@@ -54,7 +153,7 @@ void CProcessInfo::UpdateDns(const QString& HostName, const QList<QHostAddress>&
 	QList<QHostAddress> NewAddresses;
 	if (DnsEntry.isNull())
 	{
-		DnsEntry = CDnsLogEntryPtr(new CDnsLogEntry(HostName, Addresses));
+		DnsEntry = CInfoPool<CDnsLogEntry>::New(HostName, Addresses);
 		NewAddresses = Addresses;
 	}
 	else
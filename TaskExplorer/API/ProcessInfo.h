@@ -16,13 +16,90 @@
 #undef GetUserName
 #endif
 
+struct STaskSampleEx : STaskSample
+{
+	quint64			PageFaults;
+	quint64			PageFaultsDelta;
+	quint64			HardFaults;
+	quint64			HardFaultsDelta;
+	quint64			PrivateBytes;
+	quint64			PrivateBytesDelta;
+};
+
 struct STaskStatsEx : STaskStats
 {
+	void			GetSample(STaskSampleEx& Sample) const
+	{
+		STaskStats::GetSample(Sample);
+		Sample.PageFaults = PageFaultsDelta.Value;
+		Sample.PageFaultsDelta = PageFaultsDelta.Delta;
+		Sample.HardFaults = HardFaultsDelta.Value;
+		Sample.HardFaultsDelta = HardFaultsDelta.Delta;
+		Sample.PrivateBytes = PrivateBytesDelta.Value;
+		Sample.PrivateBytesDelta = PrivateBytesDelta.Delta;
+	}
+
 	SDelta32_64 	PageFaultsDelta;
 	SDelta32_64 	HardFaultsDelta;
 	SDelta64 		PrivateBytesDelta;
 };
 
+// the values of a process which change on every update, see CProcessInfo::GetSnapshot
+struct SProcessSample
+{
+	quint64			ProcessId;
+	quint64			ParentId;
+	quint64			CreateTimeStamp;
+
+	quint32			NumberOfThreads;
+	quint32			NumberOfHandles;
+	quint32			PeakNumberOfThreads;
+
+	quint64			PeakPrivateBytes;
+	quint64			WorkingSetSize;
+	quint64			PeakWorkingSetSize;
+	quint64			PrivateWorkingSetSize;
+	quint64			VirtualSize;
+	quint64			PeakVirtualSize;
+
+	long			Priority;
+	long			BasePriority;
+	long			PagePriority;
+	long			IOPriority;
+
+	STaskSampleEx	Cpu;
+	SProcSample		Stats;
+	quint32			NetworkUsageFlags;
+};
+
+// Groups of process values for the change tracking, see CProcessInfo::GetDirtyFields
+enum EProcessFields
+{
+	eProcessCpu		= 0x01, // SProcessSample::Cpu
+	eProcessIo		= 0x02, // SProcessSample::Stats
+	eProcessMemory	= 0x04, // working set and virtual size
+	eProcessCounts	= 0x08, // threads and handles
+	eProcessState	= 0x10, // everything else, names, state, priorities, token, module infos, ...
+	eProcessAll		= 0xFF
+};
+
+// Optional process values, the collectors gather them only while a view shows them, see CSystemAPI::SetProcessDemand
+enum EProcessDemand
+{
+	eDemandIo		= 0x01, // file and disk io counters
+	eDemandSwitches	= 0x02, // context switches
+	eDemandHandles	= 0x04, // handle count, on linux the open fds must be counted
+	eDemandAll		= 0xFF
+};
+
+// the part of SProcessSample which is published after every stats update, see CProcessInfo::PublishStats
+struct SProcessStatsSample
+{
+	STaskSampleEx	Cpu;
+	SProcSample		Stats;
+	quint32			NetworkUsageFlags;
+};
+
 struct SGpuStats
 {
 	STimeUsage	GpuTimeUsage;
@@ -31,6 +108,24 @@ struct SGpuStats
 	QString		GpuAdapter;
 };
 
+// Note: process ids get reused, only together with the creation time they identify a process over its entire lifetime
+struct SProcessUID
+{
+	SProcessUID(quint64 ProcessId = 0, quint64 CreateTime = 0) : ProcessId(ProcessId), CreateTime(CreateTime) {}
+
+	bool operator==(const SProcessUID& Other) const	{ return ProcessId == Other.ProcessId && CreateTime == Other.CreateTime; }
+	bool operator!=(const SProcessUID& Other) const	{ return !(*this == Other); }
+	bool operator<(const SProcessUID& Other) const	{ return ProcessId < Other.ProcessId || (ProcessId == Other.ProcessId && CreateTime < Other.CreateTime); }
+
+	quint64 ProcessId;
+	quint64 CreateTime; // as returned by GetRawCreateTime
+};
+
+inline uint qHash(const SProcessUID& UID, uint Seed = 0)
+{
+	return qHash(UID.ProcessId ^ (UID.CreateTime * 0x9E3779B97F4A7C15ULL), Seed);
+}
+
 class CProcessInfo: public CAbstractTask
 {
 	Q_OBJECT
@@ -44,6 +139,9 @@ public:
 	virtual quint64 GetParentId() const					{ QReadLocker Locker(&m_Mutex); return m_ParentProcessId; }
 	virtual QString GetName() const						{ QReadLocker Locker(&m_Mutex); return m_ProcessName; }
 
+	virtual quint64 GetRawCreateTime() const = 0;
+	virtual SProcessUID GetUID() const					{ return SProcessUID(GetProcessId(), GetRawCreateTime()); }
+
 	virtual bool ValidateParent(CProcessInfo* pParent) const = 0;
 
 	virtual QString GetArchString() const = 0;
@@ -81,6 +179,15 @@ public:
 	virtual quint64 GetMaximumWS() const = 0;
 
 	virtual STaskStatsEx GetCpuStats() const			{ QReadLocker Locker(&m_StatsMutex); return m_CpuStats; }
+
+	// Note: takes m_Mutex only once and reads the stats without locking, use this instead of the individual getters when many values are needed
+	virtual SProcessSample GetSnapshot() const;
+
+	// the groups of values which changed in the last update of the process list, see CSystemAPI::GetProcessRefresh
+	virtual quint32 GetDirtyFields() const				{ return m_DirtyFields.load(); }
+	virtual void MarkDirty(quint32 Fields)				{ m_PendingDirty.fetchAndOrOrdered(Fields); }
+	virtual const SProcessSample& CommitDirtyFields(); // called by the system api once per update of the process list, returns the committed sample
+
 	virtual SGpuStats GetGpuStats() const				{ QReadLocker Locker(&m_StatsMutex); m_GpuUpdateCounter = 0; return m_GpuStats; }
 
 	virtual QString GetStatusString() const = 0;
@@ -94,7 +201,7 @@ public:
 	virtual bool IsUserProcess() const = 0;
 	virtual bool IsElevated() const = 0;
 
-	virtual void SetNetworkUsageFlag(quint64 uFlag)			{ QWriteLocker Locker(&m_StatsMutex); m_NetworkUsageFlags |= uFlag; }
+	virtual void SetNetworkUsageFlag(quint64 uFlag);
 	virtual int GetNetworkUsageFlags() const				{ QReadLocker Locker(&m_StatsMutex); return m_NetworkUsageFlags; }
 	virtual QString GetNetworkUsageString() const;
 
@@ -230,6 +337,15 @@ protected:
 	SGpuStats						m_GpuStats;
 	volatile mutable quint32		m_GpuUpdateCounter;
 
+	// copy of the stats for the GUI, it is read without taking m_StatsMutex
+	void							PublishStats(); // m_StatsMutex must be write locked
+	CSeqLock<SProcessStatsSample>	m_StatsSample;
+
+	// change tracking, the sample values are compared on commit, everything else is marked by the collectors
+	QAtomicInt						m_PendingDirty;
+	QAtomicInt						m_DirtyFields;
+	SProcessSample					m_CommittedSample; // only used by CommitDirtyFields
+
 
 	// module info
 	CModulePtr						m_pModuleInfo;
@@ -0,0 +1,50 @@
+#pragma once
+#include <QAtomicInt>
+#include <QThread>
+#include <atomic>
+#include <string.h>
+
+// Publishes a trivially copyable value to any number of readers without them taking a lock,
+// a reader copies the value and only retries if it was overwritten in the mean time.
+// Note: Store must not be called concurrently, the owner calls it with its stats write lock held
+template <class T>
+class CSeqLock
+{
+public:
+	CSeqLock()
+	{
+		memset(&m_Value, 0, sizeof(T));
+	}
+
+	void Store(const T& Value)
+	{
+		int Seq = m_Seq.load();
+		m_Seq.store(Seq + 1); // odd while the value is being written
+		std::atomic_thread_fence(std::memory_order_release);
+		memcpy(&m_Value, &Value, sizeof(T));
+		m_Seq.storeRelease(Seq + 2);
+	}
+
+	T Load() const
+	{
+		T Value;
+		for (;;)
+		{
+			int Seq = m_Seq.loadAcquire();
+			if ((Seq & 1) == 0)
+			{
+				memcpy(&Value, &m_Value, sizeof(T));
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_Seq.load() == Seq)
+					break;
+			}
+			else // the writer got preempted in the middle of a store
+				QThread::yieldCurrentThread();
+		}
+		return Value;
+	}
+
+private:
+	QAtomicInt		m_Seq;
+	T				m_Value;
+};
@@ -2,7 +2,7 @@
 #include "ServiceInfo.h"
 
 
-CServiceInfo::CServiceInfo(QObject *parent) : CAbstractInfoEx(parent)
+CServiceInfo::CServiceInfo(QObject *parent) : QObject(parent)
 {
 	m_ProcessId = 0;
 }
@@ -4,7 +4,7 @@
 
 #include "ModuleInfo.h"
 
-class CServiceInfo: public CAbstractInfoEx
+class CServiceInfo: public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
@@ -1,7 +1,7 @@
 #include "stdafx.h"
 #include "SocketInfo.h"
 
-CSocketInfo::CSocketInfo(QObject *parent) : CAbstractInfoEx(parent)
+CSocketInfo::CSocketInfo()
 {
 	m_HashID = -1;
 
@@ -16,6 +16,24 @@ CSocketInfo::~CSocketInfo()
 {
 }
 
+SSocketSample CSocketInfo::GetSnapshot() const
+{
+	SSocketSample Sample;
+
+	QReadLocker Locker(&m_Mutex);
+	Sample.ProcessId = m_ProcessId;
+	Sample.CreateTimeStamp = m_CreateTimeStamp;
+
+	Sample.ProtocolType = m_ProtocolType;
+	Sample.State = m_State;
+	Sample.LocalPort = m_LocalPort;
+	Sample.RemotePort = m_RemotePort;
+	Locker.unlock();
+
+	Sample.Net = m_NetSample.Load();
+	return Sample;
+}
+
 bool CSocketInfo::Match(quint64 ProcessId, quint32 ProtocolType, const QHostAddress& LocalAddress, quint16 LocalPort, const QHostAddress& RemoteAddress, quint16 RemotePort, EMatchMode Mode)
 {
 	QReadLocker Locker(&m_Mutex); 
@@ -76,6 +94,7 @@ void CSocketInfo::UpdateStats()
 {
 	QWriteLocker Locker(&m_StatsMutex);
 	m_Stats.UpdateStats();
+	PublishStats();
 }
 
 QString CSocketInfo::GetProtocolString()
@@ -87,6 +106,7 @@ QString CSocketInfo::GetProtocolString()
 		case NET_TYPE_IPV6_TCP:	return tr("TCP6");
 		case NET_TYPE_IPV4_UDP:	return tr("UDP");
 		case NET_TYPE_IPV6_UDP:	return tr("UDP6");
+		case NET_TYPE_UNIX:		return tr("UNIX");
 		default:						return tr("Unknown");
     }
 }
@@ -126,6 +146,7 @@ void CSocketInfo::SetClosed()
 	m_Stats.Net.SendRawDelta.Delta = 0;
 	m_Stats.Net.ReceiveRate.Clear();
 	m_Stats.Net.SendRate.Clear();
+	PublishStats();
 }
 
 QString CSocketInfo::GetStateString()
@@ -14,19 +14,35 @@
 #define NET_TYPE_PROTOCOL_MASK		0x30
 #define NET_TYPE_PROTOCOL_TCP_SRV	0x40
 #define NET_TYPE_PROTOCOL_OTHER		0x80
+#define NET_TYPE_PROTOCOL_UNIX		0x100
 
 #define NET_TYPE_NONE 0x0
 #define NET_TYPE_IPV4_TCP (NET_TYPE_NETWORK_IPV4 | NET_TYPE_PROTOCOL_TCP)
 #define NET_TYPE_IPV6_TCP (NET_TYPE_NETWORK_IPV6 | NET_TYPE_PROTOCOL_TCP)
 #define NET_TYPE_IPV4_UDP (NET_TYPE_NETWORK_IPV4 | NET_TYPE_PROTOCOL_UDP)
 #define NET_TYPE_IPV6_UDP (NET_TYPE_NETWORK_IPV6 | NET_TYPE_PROTOCOL_UDP)
+#define NET_TYPE_UNIX (NET_TYPE_PROTOCOL_UNIX)
+
+// the values of a socket which change on every update, see CSocketInfo::GetSnapshot
+struct SSocketSample
+{
+	quint64			ProcessId;
+	quint64			CreateTimeStamp;
+
+	quint32			ProtocolType;
+	quint32			State;
+	quint16			LocalPort;
+	quint16			RemotePort;
+
+	SNetSample		Net;
+};
 
 class CSocketInfo: public CAbstractInfoEx
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(CSocketInfo)
 
 public:
-	CSocketInfo(QObject *parent = nullptr);
+	CSocketInfo();
 	virtual ~CSocketInfo();
 
 	virtual quint64				GetHashID() const			{ QReadLocker Locker(&m_Mutex); return m_HashID; }
@@ -51,6 +67,8 @@ public:
 	
 	virtual SSockStats			GetStats() const			{ QReadLocker Locker(&m_StatsMutex); return m_Stats; }
 
+	virtual SSocketSample		GetSnapshot() const;
+
 	enum EMatchMode
 	{
 		eFuzzy = 0,
@@ -84,7 +102,11 @@ protected:
 	// I/O stats
 	mutable QReadWriteLock		m_StatsMutex;
 	SSockStats					m_Stats;
+
+	// copy of the stats for the GUI, it is read without taking m_StatsMutex
+	void						PublishStats()	{ SNetSample Sample; m_Stats.Net.GetSample(Sample); m_NetSample.Store(Sample); } // m_StatsMutex must be write locked
+	CSeqLock<SNetSample>		m_NetSample;
 };
 
 typedef QSharedPointer<CSocketInfo> CSocketPtr;
-typedef QWeakPointer<CSocketInfo> CSocketRef;
\ No newline at end of file
+typedef QWeakPointer<CSocketInfo> CSocketRef;
\ No newline at end of file
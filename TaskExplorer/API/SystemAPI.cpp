@@ -18,6 +18,11 @@ int _QSet_QString_type = qRegisterMetaType<QSet<QString>>("QSet<QString>");
 // When running this in a separate thread, QObject parent must be NULL
 CSystemAPI::CSystemAPI(QObject *parent) 
 {
+	m_pProcessSnapshot = CProcessSnapshotPtr(new SProcessSnapshot());
+	m_pProcessMetrics = CProcessMetricsPtr(new SProcessMetrics());
+	m_ProcessRefresh = 0;
+	m_ProcessDemand = 0;
+
 	m_PackageCount = 0;
 	m_NumaCount = 0;
 	m_CoreCount = 0;
@@ -89,14 +94,133 @@ void CSystemAPI::InitAPI()
 
 QMap<quint64, CProcessPtr> CSystemAPI::GetProcessList()
 {
-	QReadLocker Locker(&m_ProcessMutex);
-	return m_ProcessList;
+	return GetProcessSnapshot()->List;
+}
+
+CProcessSnapshotPtr CSystemAPI::GetProcessSnapshot() const
+{
+	QMutexLocker Locker(&m_SnapshotMutex);
+	return m_pProcessSnapshot;
+}
+
+void CSystemAPI::PublishProcessList()
+{
+	// Note: the snapshot shares the map data, the collector detaches its working copy once on the next change
+	QSharedPointer<SProcessSnapshot> pSnapshot = QSharedPointer<SProcessSnapshot>(new SProcessSnapshot());
+	pSnapshot->List = m_ProcessList;
+	pSnapshot->Index.reserve(m_ProcessList.size());
+	for (QMap<quint64, CProcessPtr>::const_iterator I = m_ProcessList.constBegin(); I != m_ProcessList.constEnd(); ++I)
+		pSnapshot->Index.insert(I.key(), I.value());
+
+	QMutexLocker Locker(&m_SnapshotMutex);
+	pSnapshot->Version = m_pProcessSnapshot->Version + 1;
+	m_pProcessSnapshot = pSnapshot;
+}
+
+CProcessMetricsPtr CSystemAPI::GetProcessMetrics() const
+{
+	QMutexLocker Locker(&m_SnapshotMutex);
+	return m_pProcessMetrics;
+}
+
+void CSystemAPI::CommitProcessChanges()
+{
+	// Note: a reader which sees an odd or changed count knows that it may have gotten a mix of two updates
+	m_ProcessRefresh.fetchAndAddOrdered(1);
+
+	CProcessSnapshotPtr pSnapshot = GetProcessSnapshot();
+	int Count = pSnapshot->List.size();
+
+	QSharedPointer<SProcessMetrics> pMetrics = QSharedPointer<SProcessMetrics>(new SProcessMetrics());
+	pMetrics->Tasks.resize(Count);
+	pMetrics->UIDs.resize(Count);
+	pMetrics->CpuUsage.resize(Count);
+	pMetrics->CpuKernelUsage.resize(Count);
+	pMetrics->WorkingSetSize.resize(Count);
+	pMetrics->PrivateBytes.resize(Count);
+	pMetrics->IoReadRate.resize(Count);
+	pMetrics->IoWriteRate.resize(Count);
+	pMetrics->IoOtherRate.resize(Count);
+	pMetrics->DiskReadRate.resize(Count);
+	pMetrics->DiskWriteRate.resize(Count);
+	pMetrics->NetReceiveRate.resize(Count);
+	pMetrics->NetSendRate.resize(Count);
+
+	int i = 0;
+	for (QMap<quint64, CProcessPtr>::const_iterator I = pSnapshot->List.constBegin(); I != pSnapshot->List.constEnd(); ++I, i++)
+	{
+		// Note: the metrics are taken from the sample the dirty fields were committed with, so each process is locked only once
+		const CProcessPtr& pProcess = I.value();
+		const SProcessSample& Sample = pProcess->CommitDirtyFields();
+
+		pMetrics->Tasks[i] = pProcess;
+		pMetrics->UIDs[i] = pProcess->GetUID();
+		pMetrics->CpuUsage[i] = Sample.Cpu.CpuUsage;
+		pMetrics->CpuKernelUsage[i] = Sample.Cpu.CpuKernelUsage;
+		pMetrics->WorkingSetSize[i] = Sample.WorkingSetSize;
+		pMetrics->PrivateBytes[i] = Sample.Cpu.PrivateBytes;
+		pMetrics->IoReadRate[i] = Sample.Stats.Io.ReadRate;
+		pMetrics->IoWriteRate[i] = Sample.Stats.Io.WriteRate;
+		pMetrics->IoOtherRate[i] = Sample.Stats.Io.OtherRate;
+		pMetrics->DiskReadRate[i] = Sample.Stats.Disk.ReadRate;
+		pMetrics->DiskWriteRate[i] = Sample.Stats.Disk.WriteRate;
+		pMetrics->NetReceiveRate[i] = Sample.Stats.Net.ReceiveRate;
+		pMetrics->NetSendRate[i] = Sample.Stats.Net.SendRate;
+	}
+
+	m_ProcessRefresh.fetchAndAddOrdered(1);
+
+	QMutexLocker Locker(&m_SnapshotMutex);
+	m_pProcessMetrics = pMetrics;
+}
+
+void CSystemAPI::SetProcessDemand(QObject* pView, quint32 Demand)
+{
+	QMutexLocker Locker(&m_DemandMutex);
+
+	QHash<QObject*, quint32>::iterator I = m_DemandMap.find(pView);
+	if (Demand == 0)
+	{
+		if (I == m_DemandMap.end())
+			return;
+		m_DemandMap.erase(I);
+		disconnect(pView, SIGNAL(destroyed(QObject*)), this, SLOT(OnDemandViewDestroyed(QObject*)));
+	}
+	else if (I == m_DemandMap.end())
+	{
+		m_DemandMap.insert(pView, Demand);
+		// Note: the views live in the gui thread, a direct connection removes them before the pointer can be reused
+		connect(pView, SIGNAL(destroyed(QObject*)), this, SLOT(OnDemandViewDestroyed(QObject*)), Qt::DirectConnection);
+	}
+	else if (I.value() != Demand)
+		I.value() = Demand;
+	else
+		return;
+
+	UpdateProcessDemand();
+}
+
+void CSystemAPI::OnDemandViewDestroyed(QObject* pView)
+{
+	QMutexLocker Locker(&m_DemandMutex);
+
+	if (m_DemandMap.remove(pView))
+		UpdateProcessDemand();
+}
+
+void CSystemAPI::UpdateProcessDemand()
+{
+	// when calling this QMutexLocker Locker(&m_DemandMutex); must be locked!
+
+	quint32 Demand = 0;
+	foreach(quint32 ViewDemand, m_DemandMap)
+		Demand |= ViewDemand;
+	m_ProcessDemand = Demand;
 }
 
 CProcessPtr CSystemAPI::GetProcessByID(quint64 ProcessId, bool bAddIfNew)
 {
-	QReadLocker Locker(&m_ProcessMutex);
-	return m_ProcessList.value(ProcessId);
+	return GetProcessSnapshot()->Index.value(ProcessId);
 }
 
 QMultiMap<quint64, CSocketPtr> CSystemAPI::GetSocketList()
@@ -63,6 +63,44 @@ struct SPageFile // on linux swap partition
     quint64 PeakUsage;
 };
 
+// An immutable copy of the process list, a new one is published whenever the collector changed the list
+struct SProcessSnapshot
+{
+	SProcessSnapshot() : Version(0) {}
+
+	quint64						Version;
+	QMap<quint64, CProcessPtr>	List;	// ordered by pid, as the views expect it
+	QHash<quint64, CProcessPtr>	Index;	// for lookups by pid
+};
+
+typedef QSharedPointer<const SProcessSnapshot> CProcessSnapshotPtr;
+
+// The per tick values of all processes stored column wise, row i of every column belongs to Tasks[i],
+// whole table passes like the history graphs walk the columns instead of locking each process object
+struct SProcessMetrics
+{
+	int							size() const { return Tasks.size(); }
+
+	QVector<CProcessPtr>		Tasks;
+	QVector<SProcessUID>		UIDs;
+
+	QVector<float>				CpuUsage;
+	QVector<float>				CpuKernelUsage;
+
+	QVector<quint64>			WorkingSetSize;
+	QVector<quint64>			PrivateBytes;
+
+	QVector<quint64>			IoReadRate;
+	QVector<quint64>			IoWriteRate;
+	QVector<quint64>			IoOtherRate;
+	QVector<quint64>			DiskReadRate;
+	QVector<quint64>			DiskWriteRate;
+	QVector<quint64>			NetReceiveRate;
+	QVector<quint64>			NetSendRate;
+};
+
+typedef QSharedPointer<const SProcessMetrics> CProcessMetricsPtr;
+
 class CSystemAPI : public QObject
 {
 	Q_OBJECT
@@ -76,6 +114,14 @@ public:
 	virtual bool RootAvaiable() = 0;
 
 	virtual QMap<quint64, CProcessPtr> GetProcessList();
+	virtual CProcessSnapshotPtr GetProcessSnapshot() const;
+	virtual CProcessMetricsPtr GetProcessMetrics() const;
+	// counts the updates of the process list, it is odd while the dirty fields of the processes are being committed
+	virtual quint32 GetProcessRefresh() const			{ return m_ProcessRefresh.load(); }
+
+	// views register the optional values they show, see EProcessDemand, 0 or destroying the view unregisters it
+	virtual void SetProcessDemand(QObject* pView, quint32 Demand);
+	virtual quint32 GetProcessDemand() const			{ return m_ProcessDemand.load(); }
 	virtual CProcessPtr GetProcessByID(quint64 ProcessId, bool bAddIfNew = false);
 	virtual CThreadPtr  GetThreadByID(quint64 ThreadId);
 	virtual CProcessPtr GetProcessByThreadID(quint64 ThreadId);
@@ -193,6 +239,7 @@ public slots:
 private slots:
 	virtual bool Init() = 0;
 	virtual void OnOpenFilesUpdated();
+	virtual void OnDemandViewDestroyed(QObject* pView);
 	virtual void OnHardwareChanged() = 0;
 
 signals:
@@ -207,9 +254,23 @@ signals:
 protected:
 	//virtual void				UpdateStats();
 
+	// Note: m_ProcessList is the collectors working copy, everyone else reads the published snapshot
+	void						PublishProcessList(); // m_ProcessMutex must be locked
+	void						CommitProcessChanges(); // once per update, before ProcessListUpdated is emitted, publishes the process metrics as well
+	void						UpdateProcessDemand(); // m_DemandMutex must be locked
+
 	mutable QReadWriteLock		m_ProcessMutex;
 	QMap<quint64, CProcessPtr>	m_ProcessList;
 
+	mutable QMutex				m_SnapshotMutex; // guards only the pointer, never held while a snapshot is built or used
+	CProcessSnapshotPtr			m_pProcessSnapshot;
+	CProcessMetricsPtr			m_pProcessMetrics;
+	QAtomicInt					m_ProcessRefresh;
+
+	mutable QMutex				m_DemandMutex;
+	QHash<QObject*, quint32>	m_DemandMap;
+	QAtomicInt					m_ProcessDemand;
+
 	mutable QReadWriteLock		m_SocketMutex;
 	QMultiMap<quint64, CSocketPtr>	m_SocketList;
 
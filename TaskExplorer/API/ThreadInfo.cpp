@@ -19,6 +19,29 @@ CThreadInfo::~CThreadInfo()
 	theAPI->ClearThread(m_ThreadId);
 }
 
+SThreadSample CThreadInfo::GetSnapshot() const
+{
+	SThreadSample Sample;
+
+	QReadLocker Locker(&m_Mutex);
+	Sample.ThreadId = m_ThreadId;
+	Sample.ProcessId = m_ProcessId;
+	Sample.CreateTimeStamp = m_CreateTimeStamp;
+
+	Sample.State = m_State;
+	Sample.WaitReason = m_WaitReason;
+	Sample.IsMainThread = m_IsMainThread;
+
+	Sample.Priority = m_Priority;
+	Sample.BasePriority = m_BasePriority;
+	Sample.PagePriority = m_PagePriority;
+	Sample.IOPriority = m_IOPriority;
+	Locker.unlock();
+
+	Sample.Cpu = m_CpuSample.Load();
+	return Sample;
+}
+
 QSharedPointer<QObject>	CThreadInfo::GetProcess() const
 {
 	QReadLocker Locker(&m_Mutex); 
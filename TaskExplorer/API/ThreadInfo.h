@@ -3,6 +3,25 @@
 #include "StackTrace.h"
 #include "AbstractTask.h"
 
+// the values of a thread which change on every update, see CThreadInfo::GetSnapshot
+struct SThreadSample
+{
+	quint64			ThreadId;
+	quint64			ProcessId;
+	quint64			CreateTimeStamp;
+
+	int				State;
+	int				WaitReason;
+	bool			IsMainThread;
+
+	long			Priority;
+	long			BasePriority;
+	long			PagePriority;
+	long			IOPriority;
+
+	STaskSample		Cpu;
+};
+
 class CThreadInfo: public CAbstractTask
 {
 	Q_OBJECT
@@ -25,6 +44,8 @@ public:
 
 	virtual STaskStats GetCpuStats() const			{ QReadLocker Locker(&m_StatsMutex); return m_CpuStats; }
 
+	virtual SThreadSample GetSnapshot() const;
+
 	virtual QSharedPointer<QObject>	GetProcess() const;
 	//virtual QSharedPointer<QObject>	GetProcess() const { QReadLocker Locker(&m_Mutex); return m_pProcess; }
 	virtual void SetProcess(QSharedPointer<QObject> pProcess) { QWriteLocker Locker(&m_Mutex); m_pProcess = pProcess; }
@@ -47,6 +68,10 @@ protected:
 	QSharedPointer<QObject>	m_pProcess;
 
 	STaskStats		m_CpuStats;
+
+	// copy of the stats for the GUI, it is read without taking m_StatsMutex
+	void			PublishStats()	{ STaskSample Sample; m_CpuStats.GetSample(Sample); m_CpuSample.Store(Sample); } // m_StatsMutex must be write locked
+	CSeqLock<STaskSample> m_CpuSample;
 };
 
 typedef QSharedPointer<CThreadInfo> CThreadPtr;
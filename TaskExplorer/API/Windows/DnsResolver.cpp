@@ -399,6 +399,20 @@ void CDnsResolver::FlushDnsCache()
 }
 
 QString CDnsResolver::GetHostName(const QHostAddress& Address, QObject *receiver, const char *member)
+{
+	return LookupHostName(Address, receiver, [receiver, member](CDnsResolverJob* pJob) {
+		QObject::connect(pJob, SIGNAL(HostResolved(const QHostAddress&, const QString&)), receiver, member, Qt::QueuedConnection);
+	});
+}
+
+QString CDnsResolver::GetHostName(const QHostAddress& Address, QObject *context, const std::function<void(const QHostAddress& Address, const QString& HostName)>& Callback)
+{
+	return LookupHostName(Address, context, [context, &Callback](CDnsResolverJob* pJob) {
+		QObject::connect(pJob, &CDnsResolverJob::HostResolved, context, Callback, Qt::QueuedConnection);
+	});
+}
+
+QString CDnsResolver::LookupHostName(const QHostAddress& Address, QObject *receiver, const std::function<void(CDnsResolverJob* pJob)>& Connect)
 {
     if (receiver && !QAbstractEventDispatcher::instance(QThread::currentThread())) {
         qWarning("CDnsResolver::GetHostNames() called with no event dispatcher");
@@ -461,7 +475,7 @@ QString CDnsResolver::GetHostName(const QHostAddress& Address, QObject *receiver
 			//QObject::connect(pJob, SIGNAL(HostResolved(const QHostAddress&, const QStringList&)), this, SLOT(OnHostResolved(const QHostAddress&, const QStringList&)), Qt::QueuedConnection);
 		}
 		if (receiver)
-			QObject::connect(pJob, SIGNAL(HostResolved(const QHostAddress&, const QString&)), receiver, member, Qt::QueuedConnection);
+			Connect(pJob);
 
 		return QString();
 	}
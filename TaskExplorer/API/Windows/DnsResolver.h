@@ -1,6 +1,7 @@
 #pragma once
 #include "../DnsEntry.h"
 #include "../../../MiscHelpers/Common/Common.h"
+#include <functional>
 
 class CDnsResolverJob;
 
@@ -14,6 +15,8 @@ public:
 	virtual bool Init();
 
 	virtual QString GetHostName(const QHostAddress& Address, QObject *receiver = NULL, const char *member = NULL);
+	// the callback is invoked in the thread of the context object and is dropped together with it
+	virtual QString GetHostName(const QHostAddress& Address, QObject *context, const std::function<void(const QHostAddress& Address, const QString& HostName)>& Callback);
 
 	virtual QMultiMap<QString, CDnsCacheEntryPtr> GetEntryList() const { QReadLocker Locker(&m_Mutex);  return m_DnsCache; }
 
@@ -35,6 +38,8 @@ protected:
 
 	virtual void run();
 
+	virtual QString LookupHostName(const QHostAddress& Address, QObject *receiver, const std::function<void(CDnsResolverJob* pJob)>& Connect);
+
 	virtual QString GetHostNameSmart(const QHostAddress& Address, const QStringList& RevHostNames);
 	virtual QString GetHostNamesSmart(const QString& HostName, int Limit = 10);
 
@@ -30,7 +30,7 @@ void CWinHandleFinder::run()
 
 		QMap<quint64, HANDLE> ProcessHandles;
 
-		QList<QSharedPointer<QObject>> List;
+		QList<CHandlePtr> List;
 
 		int Modulo = handleInfo->NumberOfHandles / 100;
 		for (int i = 0; i < handleInfo->NumberOfHandles && !m_bCancel; i++)
@@ -71,12 +71,12 @@ void CWinHandleFinder::run()
 			{
 				TimeStamp = NewStamp;
 
-				emit Results(List);
+				emit HandleResults(List);
 				List.clear();
 			}
 		}
 
-		emit Results(List);
+		emit HandleResults(List);
 		List.clear();
 
 		foreach(HANDLE ProcessHandle, ProcessHandles)
@@ -608,7 +608,7 @@ NTSTATUS PhQueryMemoryItemList(
             basicInfo.AllocationBase = basicInfo.BaseAddress;
         }
 
-		memoryItem = QSharedPointer<CWinMemory>(new CWinMemory());
+		memoryItem = CInfoPool<CWinMemory>::New();
 		memoryItem->InitBasicInfo(&basicInfo, ProcessId);
 
         if (basicInfo.AllocationBase == basicInfo.BaseAddress)
@@ -650,7 +650,7 @@ NTSTATUS PhQueryMemoryItemList(
 
                     memoryItem->m_RegionSize = potentialUnusableSize;
 
-                    otherMemoryItem = QSharedPointer<CWinMemory>(new CWinMemory());
+                    otherMemoryItem = CInfoPool<CWinMemory>::New();
 					otherMemoryItem->InitBasicInfo(&basicInfo, ProcessId);
 
                     otherMemoryItem->m_BaseAddress = nextAllocationBase;
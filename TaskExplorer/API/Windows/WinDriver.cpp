@@ -34,9 +34,8 @@ bool CWinDriver::InitStaticData(struct _RTL_PROCESS_MODULE_INFORMATION* Module)
 
 	CWinModule* pModule = new CWinModule();
 	m_pModuleInfo = CModulePtr(pModule);
-	connect(pModule, SIGNAL(AsyncDataDone(bool, quint32, quint32)), this, SLOT(OnAsyncDataDone(bool, quint32, quint32)));
 	pModule->InitStaticData(m_BinaryPath);
-	pModule->InitAsyncData();
+	pModule->InitAsyncData("", this);
 
 	return true;
 }
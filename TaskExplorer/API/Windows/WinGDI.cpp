@@ -3,7 +3,7 @@
 #include "ProcessHacker.h"
 
 
-CWinGDI::CWinGDI(QObject *parent) : CAbstractInfoEx(parent)
+CWinGDI::CWinGDI(QObject *parent) : QObject(parent)
 {
 	m_HandleId = 0;
 	m_Object = -1;
@@ -2,7 +2,7 @@
 #include <qobject.h>
 #include "../AbstractInfo.h"
 
-class CWinGDI: public CAbstractInfoEx
+class CWinGDI: public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
@@ -28,8 +28,7 @@
 #include "WindowsAPI.h"
 #include "../../../MiscHelpers/Common/Settings.h"
 
-CWinHandle::CWinHandle(QObject *parent) 
-	: CHandleInfo(parent) 
+CWinHandle::CWinHandle()
 {
 	m_Object = -1;
 	m_Attributes = 0;
@@ -109,16 +108,16 @@ bool CWinHandle::InitExtData(struct _SYSTEM_HANDLE_TABLE_ENTRY_INFO_EX* handle,
 		}
 	}
 
-	m_TypeName = CastPhString(TypeName);
+	m_TypeName = CStringPool::Intern(CastPhString(TypeName));
     m_OriginalName = CastPhString(ObjectName);
-    m_FileName = CastPhString(BestObjectName);
+    m_FileName = CStringPool::Intern(CastPhString(BestObjectName));
 
 	return true;
 }
 
 QFutureWatcher<bool>* CWinHandle::InitExtDataAsync(struct _SYSTEM_HANDLE_TABLE_ENTRY_INFO_EX* handle, quint64 ProcessHandle)
 {
-	QFutureWatcher<bool>* pWatcher = new QFutureWatcher<bool>(this);
+	QFutureWatcher<bool>* pWatcher = new QFutureWatcher<bool>(); // Note: the caller waits for it and deletes it
 	pWatcher->setFuture(QtConcurrent::run(CWinHandle::InitExtDataAsync, this, handle, ProcessHandle));
 	return pWatcher;
 }
@@ -9,9 +9,9 @@
 
 class CWinHandle : public CHandleInfo
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(CWinHandle)
 public:
-	CWinHandle(QObject *parent = nullptr);
+	CWinHandle();
 	virtual ~CWinHandle();
 
 	static quint64 MakeID(quint64 HandleValue, quint64 UniqueProcessId);
@@ -154,7 +154,7 @@ private:
 class CWinHandleEx : public CWinHandle
 {
 public:
-	CWinHandleEx(QObject *parent = nullptr) : CWinHandle(parent) {}
+	CWinHandleEx() {}
 
 	virtual QString GetProcessName() const { return m_ProcessName; }
 
@@ -17,7 +17,7 @@ struct SWinJob
 };
 
 CWinJob::CWinJob(QObject *parent)
-	:CAbstractInfo(parent)
+	:QObject(parent)
 {
 	m_ActiveProcesses = 0;
 	m_TotalProcesses = 0;
@@ -32,7 +32,7 @@ struct SJobStats
 	SIOStatsEx	Io;
 };
 
-class CWinJob : public CAbstractInfo
+class CWinJob : public QObject, public CAbstractInfo
 {
 	Q_OBJECT
 public:
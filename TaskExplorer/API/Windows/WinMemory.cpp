@@ -6,8 +6,7 @@
 #include "ProcessHacker.h"
 #include "ProcessHacker/memprv.h"
 
-CWinMemory::CWinMemory(QObject *parent) 
-	: CMemoryInfo(parent) 
+CWinMemory::CWinMemory()
 {
 	memset(&u, 0, sizeof(u));
 }
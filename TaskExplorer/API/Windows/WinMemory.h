@@ -4,9 +4,9 @@
 
 class CWinMemory : public CMemoryInfo
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(CWinMemory)
 public:
-	CWinMemory(QObject *parent = nullptr);
+	CWinMemory();
 	virtual ~CWinMemory();
 
 	void	InitBasicInfo(struct _MEMORY_BASIC_INFORMATION* basicInfo, void* ProcessId);
@@ -4,10 +4,31 @@
 #include "WindowsAPI.h"
 #include "../../../MiscHelpers/Common/Settings.h"
 
-#include <QtWin>
+CWinModuleImage::CWinModuleImage(const QString& FileName, quint64 FileSize, quint64 ModificationTime)
+	: CModuleImage(FileName, FileSize, ModificationTime)
+{
+	m_AsyncDataDone = false;
+}
 
-CWinModule::CWinModule(quint64 ProcessId, bool IsSubsystemProcess, QObject *parent) 
-	: CModuleInfo(parent) 
+void CWinModuleImage::SetAsyncData(const QVariantMap& Result)
+{
+	QWriteLocker Locker(&m_Mutex);
+
+	// the version infos are the same for every job of this image, the first result fills in the shared data
+	if (m_AsyncDataDone)
+		return;
+	m_AsyncDataDone = true;
+
+	m_FileDetails.clear();
+	QVariantMap Infos = Result["Infos"].toMap();
+	foreach(const QString& Key, Infos.keys())
+		m_FileDetails[Key] = Infos[Key].toString();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// CWinModule 
+
+CWinModule::CWinModule(quint64 ProcessId, bool IsSubsystemProcess)
 {
 	m_ProcessId = ProcessId;
 	m_IsSubsystemProcess = IsSubsystemProcess;
@@ -37,8 +58,8 @@ bool CWinModule::InitStaticData(struct _PH_MODULE_INFO* module, quint64 ProcessH
 	QWriteLocker Locker(&m_Mutex);
 
 	m_IsLoaded = true;
-	m_FileName = CastPhString(module->FileName, false);
-	m_ModuleName = CastPhString(module->Name, false);
+	m_FileName = CStringPool::Intern(CastPhString(module->FileName, false));
+	m_ModuleName = CStringPool::Intern(CastPhString(module->Name, false));
 
 	m_BaseAddress = (quint64)module->BaseAddress;
 	m_EntryPoint = (quint64)module->EntryPoint;
@@ -135,7 +156,7 @@ bool CWinModule::InitStaticData(const QString& FileName)
 	QWriteLocker Locker(&m_Mutex);
 
 	m_IsLoaded = true;
-	m_FileName = FileName;
+	m_FileName = CStringPool::Intern(FileName);
 	
 	InitFileInfo();
 
@@ -144,12 +165,17 @@ bool CWinModule::InitStaticData(const QString& FileName)
 
 void CWinModule::InitFileInfo()
 {
+	quint64 ModificationTime = 0;
+	quint64 FileSize = 0;
 	FILE_NETWORK_OPEN_INFORMATION networkOpenInfo;
 	if (NT_SUCCESS(PhQueryFullAttributesFileWin32((PWSTR)m_FileName.toStdWString().c_str(), &networkOpenInfo)))
 	{
-		m_ModificationTime = FILETIME2time(networkOpenInfo.LastWriteTime.QuadPart);
-		m_FileSize = networkOpenInfo.EndOfFile.QuadPart;
+		ModificationTime = FILETIME2time(networkOpenInfo.LastWriteTime.QuadPart);
+		FileSize = networkOpenInfo.EndOfFile.QuadPart;
 	}
+
+	// Note: all modules mapping the same version of a file share one image record
+	m_pImage = CModuleImage::Find<CWinModuleImage>(m_FileName, FileSize, ModificationTime);
 }
 
 bool CWinModule::ResolveRefServices()
@@ -210,7 +236,7 @@ bool CWinModule::InitStaticData(const QVariantMap& Module)
 
 	m_IsLoaded = false;
 	//Module["Sequence"].toInt();
-	m_ModuleName = Module["ImageName"].toString();
+	m_ModuleName = CStringPool::Intern(Module["ImageName"].toString());
 	m_BaseAddress = Module["BaseAddress"].toULongLong();
 	m_Size = Module["Size"].toULongLong();
 	m_LoadTime = Module["TimeStamp"].toULongLong();
@@ -246,9 +272,13 @@ bool CWinModule::UpdateDynamicData(struct _PH_MODULE_INFO* module)
 	return modified;
 }
 
-void CWinModule::InitAsyncData(const QString& PackageFullName)
+void CWinModule::InitAsyncData(const QString& PackageFullName, QObject* pReceiver)
 {
-	QReadLocker Locker(&m_Mutex);
+	QWriteLocker Locker(&m_Mutex);
+
+	if (!m_pImage) // no file info, use a private record
+		m_pImage = CModuleImagePtr(new CWinModuleImage(m_FileName, 0, 0));
+	QSharedPointer<CWinModuleImage> pImage = m_pImage.staticCast<CWinModuleImage>();
 
 	QVariantMap Params;
 	Params["FileName"] = m_FileName;
@@ -259,10 +289,34 @@ void CWinModule::InitAsyncData(const QString& PackageFullName)
 	// so to make things simple and avoid emmory leaks we pass all params and results as a QVariantMap
 	// its not the most eficient way but its simple and reliable.
 
-	QFutureWatcher<QVariantMap>* pWatcher = new QFutureWatcher<QVariantMap>(this); // Note: the job will be canceled if the file will be deleted :D
-	connect(pWatcher, SIGNAL(resultReadyAt(int)), this, SLOT(OnInitAsyncData(int)));
-	connect(pWatcher, SIGNAL(finished()), pWatcher, SLOT(deleteLater()));
-	pWatcher->setFuture(QtConcurrent::run(CWinModule::InitAsyncData, Params));
+	// Note: the job is started only for the first module of an image with the same parameters, the others attach to the same future,
+	// a watcher set on an already finished future still reports its result.
+
+	QString AsyncDataKey = (m_IsSubsystemProcess ? "1:" : "0:") + PackageFullName;
+
+	QWriteLocker ImageLocker(&pImage->m_Mutex);
+	QMap<QString, QFuture<QVariantMap> >::iterator I = pImage->m_AsyncData.find(AsyncDataKey);
+	if (I == pImage->m_AsyncData.end())
+		I = pImage->m_AsyncData.insert(AsyncDataKey, QtConcurrent::run(CWinModule::InitAsyncData, Params));
+	QFuture<QVariantMap> AsyncData = I.value();
+	ImageLocker.unlock();
+
+	// Note: the watcher is not owned by the module, it only holds a weak reference, so the module can go away before the job finishes
+	QWeakPointer<CModuleInfo> pModule = sharedFromThis();
+	QPointer<QObject> pNotify = pReceiver;
+	QFutureWatcher<QVariantMap>* pWatcher = new QFutureWatcher<QVariantMap>();
+	QObject::connect(pWatcher, &QFutureWatcherBase::finished, pWatcher, [pWatcher, pModule, pNotify]() {
+		QSharedPointer<CWinModule> pThis = pModule.toStrongRef().staticCast<CWinModule>();
+		if (pThis && pWatcher->future().resultCount() > 0)
+		{
+			QVariantMap Result = pWatcher->result();
+			pThis->OnInitAsyncData(Result);
+			if (pNotify)
+				QMetaObject::invokeMethod(pNotify, "OnAsyncDataDone", Q_ARG(bool, Result["IsPacked"].toBool()), Q_ARG(quint32, Result["ImportFunctions"].toUInt()), Q_ARG(quint32, Result["ImportModules"].toUInt()));
+		}
+		pWatcher->deleteLater();
+	});
+	pWatcher->setFuture(AsyncData);
 }
 
 // Note: PhInitializeModuleVersionInfoCached does not look thread safe, so we have to guard it.
@@ -281,28 +335,9 @@ QVariantMap CWinModule::InitAsyncData(QVariantMap Params)
 	// PhpProcessQueryStage1 Begin
 	NTSTATUS status;
 
+	// Note: the icons are loaded on demand by the CIconCache
 	if (FileName && !IsSubsystemProcess)
 	{
-		HICON SmallIcon;
-		HICON LargeIcon;
-		if (!PhExtractIcon(FileName->Buffer, &LargeIcon, &SmallIcon))
-		{
-			LargeIcon = NULL;
-			SmallIcon = NULL;
-		}
-
-		if (SmallIcon)
-		{
-			Result["SmallIcon"] = QtWin::fromHICON(SmallIcon);
-			DestroyIcon(SmallIcon);
-		}
-
-		if (LargeIcon)
-		{
-			Result["LargeIcon"] = QtWin::fromHICON(LargeIcon);
-			DestroyIcon(LargeIcon);
-		}
-
 		// Version info.
 		QMutexLocker Lock(&g_ModuleVersionInfoCachedMutex);
 		PhInitializeImageVersionInfoCached(&VersionInfo, FileName, FALSE);
@@ -360,21 +395,12 @@ QVariantMap CWinModule::InitAsyncData(QVariantMap Params)
 	return Result;
 }
 
-void CWinModule::OnInitAsyncData(int Index)
+void CWinModule::OnInitAsyncData(const QVariantMap& Result)
 {
-	QFutureWatcher<QVariantMap>* pWatcher = (QFutureWatcher<QVariantMap>*)sender();
-
-	QVariantMap Result = pWatcher->resultAt(Index);
-
 	QWriteLocker Locker(&m_Mutex);
 
-	m_SmallIcon = Result["SmallIcon"].value<QPixmap>();
-	m_LargeIcon = Result["LargeIcon"].value<QPixmap>();
-
-	m_FileDetails.clear();
-	QVariantMap Infos = Result["Infos"].toMap();
-	foreach(const QString& Key, Infos.keys())
-		m_FileDetails[Key] = Infos[Key].toString();
+	if (m_pImage)
+		m_pImage.staticCast<CWinModuleImage>()->SetAsyncData(Result);
 
 	m_VerifyResult = (EVerifyResult)Result["VerifyResult"].toInt();
 	m_VerifySignerName = Result["VerifySignerName"].toString();
@@ -382,8 +408,6 @@ void CWinModule::OnInitAsyncData(int Index)
 	m_IsPacked = Result["IsPacked"].toBool();
 	m_ImportFunctions = Result["ImportFunctions"].toUInt();
 	m_ImportModules = Result["ImportModules"].toUInt();
-
-	emit AsyncDataDone(Result["IsPacked"].toBool(), Result["ImportFunctions"].toUInt(), Result["ImportModules"].toUInt());
 }
 
 QString CWinModule::GetTypeString() const
@@ -553,8 +577,8 @@ STATUS CWinModule::Unload(bool bForce)
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // CWinMainModule 
 
-CWinMainModule::CWinMainModule(QObject *parent) 
-	: CWinModule(-1, false, parent) 
+CWinMainModule::CWinMainModule() 
+	: CWinModule(-1, false) 
 {
 	m_ImageSubsystem = 0;
 	m_PebBaseAddress = 0;
@@ -1,11 +1,29 @@
 #pragma once
 #include "../ModuleInfo.h"
 
+class CWinModuleImage : public CModuleImage
+{
+public:
+	CWinModuleImage(const QString& FileName, quint64 FileSize, quint64 ModificationTime);
+
+	void SetAsyncData(const QVariantMap& Result);
+
+protected:
+	friend class CWinModule;
+
+	bool						m_AsyncDataDone;
+	// the signature check depends on the package and the subsystem of the process, hence one job per combination, see AsyncDataKey
+	QMap<QString, QFuture<QVariantMap> > m_AsyncData;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// CWinModule 
+
 class CWinModule : public CModuleInfo
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(CWinModule)
 public:
-	CWinModule(quint64 ProcessId = -1, bool IsSubsystemProcess = false, QObject *parent = nullptr);
+	CWinModule(quint64 ProcessId = -1, bool IsSubsystemProcess = false);
 	virtual ~CWinModule();
 
 	virtual quint64 GetEntryPoint() const 					{ QReadLocker Locker(&m_Mutex); return m_EntryPoint; }
@@ -46,13 +64,12 @@ public:
 	virtual quint32 GetImportModules() const 				{ QReadLocker Locker(&m_Mutex); return m_ImportModules; }
 
 
-	void InitAsyncData(const QString& PackageFullName = "");
+	// the receiver's OnAsyncDataDone(bool IsPacked, quint32 ImportFunctions, quint32 ImportModules) slot is invoked once the data are available,
+	// the module must be held by a QSharedPointer already
+	void InitAsyncData(const QString& PackageFullName = "", QObject* pReceiver = NULL);
 
 	virtual STATUS				Unload(bool bForce = false);
 
-signals:
-	void	AsyncDataDone(bool IsPacked, quint32 ImportFunctions, quint32 ImportModules);
-
 protected:
 	friend class CWinProcess;
 	friend class CWinDriver;
@@ -89,8 +106,7 @@ protected:
 	quint32						m_ImportFunctions;
 	quint32						m_ImportModules;
 
-protected slots:
-	void OnInitAsyncData(int Index);
+	void OnInitAsyncData(const QVariantMap& Result);
 
 private:
 	static QVariantMap InitAsyncData(QVariantMap Params);
@@ -101,9 +117,8 @@ private:
 
 class CWinMainModule : public CWinModule
 {
-	Q_OBJECT
 public:
-	CWinMainModule(QObject *parent = nullptr);
+	CWinMainModule();
 	virtual ~CWinMainModule() {}
 	
 	virtual quint16 GetImageSubsystem() const 				{ QReadLocker Locker(&m_Mutex); return m_ImageSubsystem; }
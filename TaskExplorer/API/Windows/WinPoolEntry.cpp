@@ -2,7 +2,7 @@
 #include "WinPoolEntry.h"
 #include "ProcessHacker.h"
 
-CWinPoolEntry::CWinPoolEntry(QObject *parent) : CAbstractInfoEx(parent)
+CWinPoolEntry::CWinPoolEntry(QObject *parent) : QObject(parent)
 {
 }
 
@@ -15,7 +15,7 @@ struct SPoolEntryStats
     SDelta64 NonPagedTotalSizeDelta;
 };
 
-class CWinPoolEntry: public CAbstractInfoEx
+class CWinPoolEntry: public QObject, public CAbstractInfoEx
 {
 	Q_OBJECT
 
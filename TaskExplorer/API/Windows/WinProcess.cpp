@@ -219,7 +219,7 @@ bool CWinProcess::InitStaticData(quint64 ProcessId)
 	}
 
 	int pos = m_FileName.lastIndexOf("\\");
-	m_ProcessName = m_FileName.mid(pos + 1);
+	m_ProcessName = CStringPool::Intern(m_FileName.mid(pos + 1));
 
 	return true;
 }
@@ -246,13 +246,13 @@ bool CWinProcess::InitStaticData(struct _SYSTEM_PROCESS_INFORMATION* Process, bo
 			PPH_STRING newFileName = PhGetFileName(fileName);
 			PhDereferenceObject(fileName);
 
-			m_FileName = CastPhString(newFileName);
+			m_FileName = CStringPool::Intern(CastPhString(newFileName));
 
 			int pos = m_FileName.lastIndexOf("\\");
-			m_ProcessName = m_FileName.mid(pos+1);
+			m_ProcessName = CStringPool::Intern(m_FileName.mid(pos+1));
 		}
 		else
-			m_ProcessName = QString::fromWCharArray(Process->ImageName.Buffer, Process->ImageName.Length / sizeof(wchar_t));
+			m_ProcessName = CStringPool::Intern(QString::fromWCharArray(Process->ImageName.Buffer, Process->ImageName.Length / sizeof(wchar_t)));
 	}
 	else
 		m_ProcessName = QString::fromWCharArray(SYSTEM_IDLE_PROCESS_NAME);
@@ -438,7 +438,7 @@ bool CWinProcess::InitStaticData(bool bLoadFileName)
 		PPH_STRING fileName = PhGetKernelFileName();
 		if (fileName)
 		{
-			m_FileName = CastPhString(PhGetFileName(fileName));
+			m_FileName = CStringPool::Intern(CastPhString(PhGetFileName(fileName)));
 			PhDereferenceObject(fileName);
 		}
 	}
@@ -459,7 +459,7 @@ bool CWinProcess::InitStaticData(bool bLoadFileName)
 
 		if (NT_SUCCESS(status))
 		{
-			m_FileName = CastPhString(PhGetFileName(fileName));
+			m_FileName = CStringPool::Intern(CastPhString(PhGetFileName(fileName)));
 			PhDereferenceObject(fileName);
 		}
 	}
@@ -551,7 +551,7 @@ bool CWinProcess::InitStaticData(bool bLoadFileName)
                         commandLine->Buffer[i] = ' ';
                 }
 
-                m_CommandLine = CastPhString(commandLine);
+                m_CommandLine = CStringPool::Intern(CastPhString(commandLine));
             }
         }
 
@@ -644,15 +644,14 @@ void CWinProcess::UpdateModuleInfo()
 {
 	CWinMainModule* pModule = new CWinMainModule();
 	m_pModuleInfo = CModulePtr(pModule);
-	connect(pModule, SIGNAL(AsyncDataDone(bool, quint32, quint32)), this, SLOT(OnAsyncDataDone(bool, quint32, quint32)));
 	pModule->InitStaticData(m_ProcessId, m_FileName, m->IsSubsystemProcess, m->IsWow64);
-	pModule->InitAsyncData(m->PackageFullName);
+	pModule->InitAsyncData(m->PackageFullName, this);
 }
 
 void CWinProcess::SetFileName(const QString& FileName)
 { 
 	QWriteLocker Locker(&m_Mutex); 
-	m_FileName = FileName; 
+	m_FileName = CStringPool::Intern(FileName); 
 
 	if (m_pModuleInfo.isNull())
 		UpdateModuleInfo();
@@ -719,7 +718,11 @@ bool CWinProcess::UpdateDynamicData(struct _SYSTEM_PROCESS_INFORMATION* Process,
         modified = TRUE;
     }
 
-    m->IsPartiallySuspended = isPartiallySuspended;
+    if (m->IsPartiallySuspended != isPartiallySuspended)
+    {
+        m->IsPartiallySuspended = isPartiallySuspended;
+        modified = TRUE;
+    }
 
 	//bool IsOrWasRunning = m->IsOrWasRunning
 	// We want to detect if a process was already running or was CREATE_SUSPENDED and not resumed yet
@@ -879,30 +882,43 @@ bool CWinProcess::UpdateDynamicData(struct _SYSTEM_PROCESS_INFORMATION* Process,
 		// Note: The immersive state of a process can never change. No need to update it like Process Hacker does
 
 		// GDI, USER handles
-		m_GdiHandles = GetGuiResources(m->QueryHandle, GR_GDIOBJECTS);
-		m_UserHandles = GetGuiResources(m->QueryHandle, GR_USEROBJECTS);
+		quint32 GdiHandles = GetGuiResources(m->QueryHandle, GR_GDIOBJECTS);
+		quint32 UserHandles = GetGuiResources(m->QueryHandle, GR_USEROBJECTS);
+		if (m_GdiHandles != GdiHandles || m_UserHandles != UserHandles)
+		{
+			m_GdiHandles = GdiHandles;
+			m_UserHandles = UserHandles;
+			modified = TRUE;
+		}
 
 		// DEP Status
 		ULONG depStatus = 0;
-		if (NT_SUCCESS(PhGetProcessDepStatus(m->QueryHandle, &depStatus)))
+		if (NT_SUCCESS(PhGetProcessDepStatus(m->QueryHandle, &depStatus)) && m->DepStatus != depStatus)
+		{
 			m->DepStatus = depStatus;
+			modified = TRUE;
+		}
 
 		// Protection
 		if (WindowsVersion >= WINDOWS_8_1)
 		{
 			// Note: the protection state of a process shouldn't be able to change, but with the right kernel driver it can.
 			PS_PROTECTION protection;
-			if (NT_SUCCESS(PhGetProcessProtection(m->QueryHandle, &protection)))
+			if (NT_SUCCESS(PhGetProcessProtection(m->QueryHandle, &protection)) && m->Protection.Level != protection.Level)
 			{
 				m->Protection.Level = protection.Level;
 				m->IsProtectedProcess = m->Protection.Level != 0;
+				modified = TRUE;
 			}
 		}
 
 		// update critical flag
 		BOOLEAN breakOnTermination;
-		if (NT_SUCCESS(PhGetProcessBreakOnTermination(m->QueryHandle, &breakOnTermination)))
+		if (NT_SUCCESS(PhGetProcessBreakOnTermination(m->QueryHandle, &breakOnTermination)) && m_IsCritical != (breakOnTermination != FALSE))
+		{
 			m_IsCritical = breakOnTermination;
+			modified = TRUE;
+		}
 
 		//if(PH_IS_REAL_PROCESS_ID(m->UniqueProcessId)) // WARNING: querying WsCounters causes very high CPU load !!!
 		//	PhGetProcessWsCounters(m->QueryHandle, &m->WsCounters); 
@@ -914,10 +930,11 @@ bool CWinProcess::UpdateDynamicData(struct _SYSTEM_PROCESS_INFORMATION* Process,
 		if (WindowsVersion >= WINDOWS_10_RS3)
 			PhGetProcessUptime(m->QueryHandle, &m->UptimeInfo);
 	}
-    else
+    else if (m_GdiHandles != 0 || m_UserHandles != 0)
     {
         m_GdiHandles = 0;
         m_UserHandles = 0;
+        modified = TRUE;
     }
 
 	// Note: dont keep the handle open for thereads we are not looking at.
@@ -958,6 +975,8 @@ bool CWinProcess::UpdateDynamicData(struct _SYSTEM_PROCESS_INFORMATION* Process,
 
 	m_Stats.UpdateStats();
 
+	PublishStats();
+
 	return modified;
 }
 
@@ -977,6 +996,7 @@ void CWinProcess::UpdateCPUCycles(quint64 sysTotalTime, quint64 sysTotalCycleTim
 {
 	QWriteLocker StatsLocker(&m_StatsMutex);
 	m_CpuStats.UpdateStats(sysTotalTime, sysTotalCycleTime);
+	PublishStats();
 }
 
 /*bool CWinProcess::UpdateDynamicDataExt()
@@ -1148,6 +1168,8 @@ void CWinProcess::UnInit()
 	m_Stats.Disk.WriteRawDelta.Delta = 0;
 	m_Stats.Disk.ReadRate.Clear();
 	m_Stats.Disk.WriteRate.Clear();
+
+	PublishStats();
 }
 
 NTSTATUS PhEnumHandlesGeneric(_In_ HANDLE ProcessId, _In_ HANDLE ProcessHandle, _Out_ PSYSTEM_HANDLE_INFORMATION_EX *Handles, _Out_ PBOOLEAN FilterNeeded);
@@ -1207,7 +1229,7 @@ bool CWinProcess::UpdateHandles()
 		bool bAdd = false;
 		if (pWinHandle.isNull())
 		{
-			pWinHandle = QSharedPointer<CWinHandle>(new CWinHandle());
+			pWinHandle = CInfoPool<CWinHandle>::New();
 			bAdd = true;
 			QWriteLocker Locker(&m_HandleMutex);
 			ASSERT(!m_HandleList.contains(HandleID));
@@ -93,7 +93,6 @@ bool CWinService::InitStaticData(struct _ENUM_SERVICE_STATUS_PROCESSW* service)
 
 	CWinModule* pModule = new CWinModule();
 	m_pModuleInfo = CModulePtr(pModule);
-	connect(pModule, SIGNAL(AsyncDataDone(bool, quint32, quint32)), this, SLOT(OnAsyncDataDone(bool, quint32, quint32)));
 
 	return true;
 }
@@ -188,7 +187,7 @@ bool CWinService::UpdateDynamicData(void* pscManagerHandle, struct _ENUM_SERVICE
 				{
 					m_FileName = FileName;
 					if(!m_FileName.isEmpty() && !m_pModuleInfo.isNull())
-						qobject_cast<CWinModule*>(m_pModuleInfo)->InitAsyncData(m_FileName);
+						m_pModuleInfo.staticCast<CWinModule>()->InitAsyncData(m_FileName, this);
 				}
 
 				PhFree(config);
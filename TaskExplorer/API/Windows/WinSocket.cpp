@@ -58,8 +58,7 @@ struct SWinSocket
 	ET_FIREWALL_STATUS FwStatus;
 };
 
-CWinSocket::CWinSocket(QObject *parent) 
-	: CSocketInfo(parent) 
+CWinSocket::CWinSocket() 
 {
 	//m_SubsystemProcess = false;
 
@@ -118,7 +117,7 @@ bool CWinSocket::InitStaticData(quint64 ProcessId, quint32 ProtocolType,
 	m_ProcessId = ProcessId;
 
 	if(m_ProcessId == 0)
-		m_ProcessName = tr("Waiting connections");
+		m_ProcessName = CStringPool::Intern(tr("Waiting connections"));
 	else
 		m_ProcessName = tr("Unknown process PID: %1").arg(m_ProcessId);
 
@@ -154,8 +153,12 @@ bool CWinSocket::InitStaticDataEx(SSocket* connection, bool IsNew)
 		m->RemoteScopeId = connection->RemoteScopeId;
 	}
 
-	// DNS host name handling
-	m_RemoteHostName = ((CWindowsAPI*)theAPI)->GetDnsResolver()->GetHostName(m_RemoteAddress, this, SLOT(OnHostResolved(const QHostAddress&, const QString&)));
+	// DNS host name handling, the socket may be gone by the time the name is resolved
+	QWeakPointer<CWinSocket> pSocket = sharedFromThis();
+	m_RemoteHostName = ((CWindowsAPI*)theAPI)->GetDnsResolver()->GetHostName(m_RemoteAddress, theAPI, [pSocket](const QHostAddress& Address, const QString& HostName) {
+		if (QSharedPointer<CWinSocket> pThis = pSocket.toStrongRef())
+			pThis->OnHostResolved(Address, HostName);
+	});
 
 	CProcessPtr pProcess = m_pProcess.toStrongRef().staticCast<CProcessInfo>();
 	if (!pProcess.isNull())
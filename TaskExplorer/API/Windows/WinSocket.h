@@ -4,11 +4,11 @@
 
 #define PH_NETWORK_OWNER_INFO_SIZE 16
 
-class CWinSocket : public CSocketInfo
+class CWinSocket : public CSocketInfo, public QEnableSharedFromThis<CWinSocket> // Note: the async host name lookup reports to a weak reference
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(CWinSocket)
 public:
-	CWinSocket(QObject *parent = nullptr);
+	CWinSocket();
 	virtual ~CWinSocket();
 
 	//static QHostAddress PH2QAddress(struct _PH_IP_ADDRESS* addr);
@@ -48,7 +48,6 @@ public:
 
 	static QVector<SSocket> GetNetworkConnections();
 
-public slots:
 	void			OnHostResolved(const QHostAddress& Address, const QString& HostName);
 
 protected:
@@ -187,6 +187,8 @@ bool CWinThread::UpdateDynamicData(struct _SYSTEM_THREAD_INFORMATION* thread, qu
 	// If the cycle time isn't available, we'll fall back to using the CPU time.
 	m_CpuStats.UpdateStats(sysTotalTime, (m_ProcessId == (quint64)SYSTEM_IDLE_PROCESS_ID || m->ThreadHandle) ? sysTotalCycleTime : 0);
 
+	PublishStats();
+
 	StatsLocker.unlock();
 
 	// Update the GUI thread status.
@@ -341,6 +343,8 @@ void CWinThread::UnInit()
 	m_CpuStats.CpuUsage = 0;
 	m_CpuStats.CpuKernelUsage = 0;
 	m_CpuStats.CpuUserUsage = 0;
+
+	PublishStats();
 }
 
 quint64 CWinThread::TraceStack()
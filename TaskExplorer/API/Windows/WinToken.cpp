@@ -50,7 +50,7 @@ struct SWinToken
 };
 
 CWinToken::CWinToken(QObject *parent)
-	:CAbstractInfo(parent)
+	:QObject(parent)
 {
 	m_IsAppContainer = false;
 	m_SessionId = 0;
@@ -60,6 +60,7 @@ CWinToken::CWinToken(QObject *parent)
 	m_Virtualization = 0;
 
 	m_TokenState = eNotInitialized;
+	m_NamesResolved = false;
 
 	m = new SWinToken();
 }
@@ -111,6 +112,8 @@ void CWinToken::OnSidResolved(const QByteArray& SID, const QString& Name)
 {
 	QWriteLocker Locker(&m_Mutex);
 
+	m_NamesResolved = true;
+
 	if(SID == m_UserSid)
 		m_UserName = Name;
 
@@ -186,13 +189,17 @@ bool CWinToken::UpdateDynamicData(bool MonitorChange, bool IsOrWasRunning)
 {
 	QWriteLocker Locker(&m_Mutex);
 
+	// the names resolved in the mean time are a change as well
+	bool bNamesResolved = m_NamesResolved;
+	m_NamesResolved = false;
+
 	// When token data has been initialized and we are not monitoring for Token changes we can return here.
 	if (m_TokenState == eInitialized && !MonitorChange)
-		return false;
+		return bNamesResolved;
 
 	HANDLE tokenHandle = NULL;
 	if (!NT_SUCCESS(CWinToken__OpenProcessToken(&tokenHandle, TOKEN_QUERY, m)))
-		return false;
+		return bNamesResolved;
 
 
 	// if we are monitoring Token change we always update some values
@@ -255,7 +262,7 @@ bool CWinToken::UpdateDynamicData(bool MonitorChange, bool IsOrWasRunning)
 			{
 				NtClose(tokenHandle);
 
-				return false;
+				return bNamesResolved;
 			}
 		}
 		else
@@ -10,7 +10,7 @@
 
 #undef GetUserName
 
-class CWinToken : public CAbstractInfo
+class CWinToken : public QObject, public CAbstractInfo
 {
 	Q_OBJECT
 public:
@@ -243,6 +243,7 @@ protected:
 		eInitialized,
 		eHasChanged
 	}			m_TokenState;
+	bool		m_NamesResolved;
 
 	QMap<QByteArray, SGroup> m_Groups;
 	QMap<QString, SPrivilege> m_Privileges;
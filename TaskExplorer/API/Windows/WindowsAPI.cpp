@@ -833,13 +833,23 @@ bool CWindowsAPI::UpdateProcessList()
 
 		// take all running processes out of the copyed map
 		QSharedPointer<CWinProcess> pProcess = OldProcesses.take(ProcessID).staticCast<CWinProcess>();
+
+		// Note: if the pid was reused the process we know has terminated, its entry can not be kept and is replaced by the new one
+		bool bReused = !pProcess.isNull() && pProcess->IsFullyInitialized() && pProcess->GetUID() != SProcessUID(ProcessID, process->CreateTime.QuadPart);
+		if (bReused)
+		{
+			pProcess->MarkForRemoval();
+			pProcess->UnInit();
+			pProcess.clear();
+		}
+
 		bool bAdd = false;
 		if (pProcess.isNull())
 		{
 			pProcess = QSharedPointer<CWinProcess>(new CWinProcess());
 			bAdd = pProcess->InitStaticData(process, bFullProcessInfo);
 			QWriteLocker Locker(&m_ProcessMutex);
-			ASSERT(!m_ProcessList.contains(ProcessID));
+			ASSERT(bReused || !m_ProcessList.contains(ProcessID));
 			m_ProcessList.insert(ProcessID, pProcess);
 		}
 		else if(!pProcess->IsFullyInitialized())
@@ -856,9 +866,18 @@ bool CWindowsAPI::UpdateProcessList()
 
 		//pProcess->UpdateThreadData(process, bFullProcessInfo, EnableCycleCpuUsage ? 0 : (iLinuxStyleCPU ? sysTotalTimePerCPU : sysTotalTime)); // a thread can ever only use one CPU to use linux style ylways
 
-		pProcess->UpdateTokenData(MonitorTokenChange);
+		// Note: the async module infos are reported by UpdateDynamicData and the resolved sid names by UpdateTokenData
+		if (pProcess->UpdateTokenData(MonitorTokenChange))
+			bChanged = true;
+
+		quint32 WndHandles = GetWindowByPID((quint64)process->UniqueProcessId).count();
+		if (pProcess->GetWndHandles() != WndHandles)
+			bChanged = true;
+		pProcess->SetWndHandles(WndHandles);
 
-		pProcess->SetWndHandles(GetWindowByPID((quint64)process->UniqueProcessId).count());
+		// the sampled values are tracked by CommitDirtyFields
+		if (bAdd || bChanged)
+			pProcess->MarkDirty(eProcessState);
 
 		if (bAdd)
 			Added.insert(ProcessID);
@@ -909,6 +928,10 @@ bool CWindowsAPI::UpdateProcessList()
         }
 	}
 
+	QWriteLocker ListLocker(&m_ProcessMutex);
+	PublishProcessList();
+	ListLocker.unlock();
+
 	QMap<quint64, CProcessPtr>	Processes = GetProcessList();
 
 	if (EnableCycleCpuUsage)
@@ -955,9 +978,12 @@ bool CWindowsAPI::UpdateProcessList()
 
 			pProcess->MarkForRemoval();
 			pProcess->UnInit();
+			pProcess->MarkDirty(eProcessState);
 			Changed.insert(ProcessID);
 		}
 	}
+	if (!Removed.isEmpty())
+		PublishProcessList();
 	Locker.unlock();
 
 	// Cache processes for later use when updating threads
@@ -972,6 +998,15 @@ bool CWindowsAPI::UpdateProcessList()
 
 	// PhFree(processes);
 
+	CommitProcessChanges();
+
+	// drop the names and paths which were only used by processes that are gone by now, and the record chunks they left empty
+	if (!Removed.isEmpty())
+	{
+		CStringPool::Purge();
+		CInfoPoolBase::TrimAll();
+	}
+
 	emit ProcessListUpdated(Added, Changed, Removed);
 
 	QWriteLocker StatsLocker(&m_StatsMutex);
@@ -1090,6 +1125,7 @@ CProcessPtr CWindowsAPI::GetProcessByID(quint64 ProcessId, bool bAddIfNew)
 		pProcess->InitStaticData(ProcessId);
 		//ASSERT(!m_ProcessList.contains(ProcessId)); 
 		m_ProcessList.insert(ProcessId, pProcess);
+		PublishProcessList();
 	}
 	return pProcess;
 }
@@ -1559,7 +1595,7 @@ bool CWindowsAPI::UpdateOpenFileList()
 		bool bAdd = false;
 		if (pWinHandle.isNull())
 		{
-			pWinHandle = QSharedPointer<CWinHandle>(new CWinHandle());
+			pWinHandle = CInfoPool<CWinHandle>::New();
 			bAdd = true;
 		}
 		
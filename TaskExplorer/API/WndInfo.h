@@ -8,7 +8,7 @@
 #undef IsMaximized
 #endif
 
-class CWndInfo: public CAbstractInfo
+class CWndInfo: public QObject, public CAbstractInfo
 {
 	Q_OBJECT
 
@@ -44,7 +44,7 @@ void CHandleModel::Sync(QMap<quint64, CHandlePtr> HandleList)
 		}
 
 #ifdef WIN32
-		CWinHandle* pWinHandle = qobject_cast<CWinHandle*>(pHandle.data());
+		CWinHandle* pWinHandle = static_cast<CWinHandle*>(pHandle.data());
 #endif
 
 		int Col = 0;
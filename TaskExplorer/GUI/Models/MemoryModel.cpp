@@ -81,7 +81,7 @@ void CMemoryModel::UpdateMemory(const CMemoryPtr& pMemory, SMemoryNode* pNode, Q
 		//	emit dataChanged(createIndex(Index.row(), 0, pNode), createIndex(Index.row(), columnCount()-1, pNode));
 
 #ifdef WIN32
-	CWinMemory* pWinMemory = qobject_cast<CWinMemory*>(pMemory.data());
+	CWinMemory* pWinMemory = static_cast<CWinMemory*>(pMemory.data());
 #endif
 
 	int Col = 0;
@@ -111,7 +111,7 @@ QSet<quint64> CModuleModel::Sync(const QMap<quint64, CModulePtr>& ModuleList)
 		}
 
 #ifdef WIN32
-		CWinModule* pWinModule = qobject_cast<CWinModule*>(pModule.data());
+		CWinModule* pWinModule = static_cast<CWinModule*>(pModule.data());
 #endif
 
 		for(int section = 0; section < columnCount(); section++)
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "../TaskExplorer.h"
 #include "ProcessModel.h"
+#include "../../API/IconCache.h"
 #include "../../../MiscHelpers/Common/Common.h"
 #ifdef WIN32
 #include "../../API/Windows/WinProcess.h"
@@ -19,8 +20,16 @@ CProcessModel::CProcessModel(QObject *parent)
 
 	m_bUseIcons = true;
 	m_iUseDescr = 1;
+	m_bClearZeros = true;
+
+	m_SyncedRefresh = 0;
+	m_bSyncValid = false;
+	m_SyncedOptions = 0;
 
 	m_Columns.insert(eProcess);
+
+	// Note: the icons are looked up when the view asks for them, not during the sync
+	connect(CIconCache::Instance(), SIGNAL(IconsReady()), this, SLOT(OnIconsReady()));
 }
 
 CProcessModel::~CProcessModel()
@@ -69,6 +78,151 @@ bool CProcessModel::TestProcPath(const QList<QVariant>& Path, const CProcessPtr&
 	return Path.size() == Index;
 }
 
+quint32 CProcessModel::GetColumnFields(int section)
+{
+	switch (section)
+	{
+		case eCPU_History:
+		case eCPU:
+		case eTotalCPU_Time:
+		case eKernelCPU_Time:
+		case eUserCPU_Time:
+		case eContextSwitches:
+		case eContextSwitchesDelta:
+		case eCycles:
+		case eCyclesDelta:
+		case ePrivateBytes:
+		case ePrivateBytesDelta:
+		case ePageFaults:
+		case ePageFaultsDelta:
+		case eHardFaults:
+		case eHardFaultsDelta:
+									return eProcessCpu;
+
+		case eIO_History:
+		case eIO_TotalRate:
+		case eIO_Reads:
+		case eIO_Writes:
+		case eIO_Other:
+		case eIO_ReadBytes:
+		case eIO_WriteBytes:
+		case eIO_OtherBytes:
+		case eIO_ReadsDelta:
+		case eIO_WritesDelta:
+		case eIO_OtherDelta:
+		case eIO_ReadBytesDelta:
+		case eIO_WriteBytesDelta:
+		case eIO_OtherBytesDelta:
+		case eIO_ReadRate:
+		case eIO_WriteRate:
+		case eIO_OtherRate:
+		case eNET_History:
+		case eNet_TotalRate:
+		case eReceives:
+		case eSends:
+		case eReceiveBytes:
+		case eSendBytes:
+		case eReceivesDelta:
+		case eSendsDelta:
+		case eReceiveBytesDelta:
+		case eSendBytesDelta:
+		case eReceiveRate:
+		case eSendRate:
+		case eDisk_TotalRate:
+		case eReads:
+		case eWrites:
+		case eReadBytes:
+		case eWriteBytes:
+		case eReadsDelta:
+		case eWritesDelta:
+		case eReadBytesDelta:
+		case eWriteBytesDelta:
+		case eReadRate:
+		case eWriteRate:
+									return eProcessIo;
+
+		case eMEM_History:
+		case ePeakPrivateBytes:
+		case eWorkingSet:
+		case ePeakWS:
+		case ePrivateWS:
+		case eVirtualSize:
+		case ePeakVirtualSize:
+									return eProcessMemory;
+
+		case eHandles:
+		case eThreads:
+		case ePeakThreads:
+									return eProcessCounts;
+
+		// Note: this values are not tracked, they are re-read on every sync
+		case eUpTime:
+		case eGPU_History:
+		case eVMEM_History:
+		case eGPU_Usage:
+		case eGPU_Shared:
+		case eGPU_Dedicated:
+		case eGPU_Adapter:
+		case eSharedWS:
+		case eShareableWS:
+		case eMinimumWS:
+		case eMaximumWS:
+		case ePeakHandles:
+		case eDebugTotal:
+		case eWindowTitle:
+		case eWindowStatus:
+									return 0;
+
+		default:					return eProcessState;
+	}
+}
+
+quint32 CProcessModel::GetColumnDemand(int section)
+{
+	switch (section)
+	{
+		case eIO_History:
+		case eIO_TotalRate:
+		case eIO_Reads:
+		case eIO_Writes:
+		case eIO_Other:
+		case eIO_ReadBytes:
+		case eIO_WriteBytes:
+		case eIO_OtherBytes:
+		case eIO_ReadsDelta:
+		case eIO_WritesDelta:
+		case eIO_OtherDelta:
+		case eIO_ReadBytesDelta:
+		case eIO_WriteBytesDelta:
+		case eIO_OtherBytesDelta:
+		case eIO_ReadRate:
+		case eIO_WriteRate:
+		case eIO_OtherRate:
+		case eDisk_TotalRate:
+		case eReads:
+		case eWrites:
+		case eReadBytes:
+		case eWriteBytes:
+		case eReadsDelta:
+		case eWritesDelta:
+		case eReadBytesDelta:
+		case eWriteBytesDelta:
+		case eReadRate:
+		case eWriteRate:
+									return eDemandIo;
+
+		case eContextSwitches:
+		case eContextSwitchesDelta:
+									return eDemandSwitches;
+
+		case eHandles:
+		case ePeakHandles:
+									return eDemandHandles;
+
+		default:					return 0;
+	}
+}
+
 QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 {
 	QSet<quint64> Added;
@@ -76,7 +230,7 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 	QHash<QVariant, STreeNode*> Old = m_Map;
 
 	bool bShow32 = theConf->GetBool("Options/Show32", true);
-	bool bClearZeros = theConf->GetBool("Options/ClearZeros", true);
+	m_bClearZeros = theConf->GetBool("Options/ClearZeros", true);
 	int iHighlightMax = theConf->GetInt("Options/HighLoadHighlightCount", 5);
 	time_t curTime = GetTime();
 
@@ -85,6 +239,16 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 	bool IsMonitoringETW = ((CWindowsAPI*)theAPI)->IsMonitoringETW();
 #endif
 
+	// Note: when we got every update of the process list since the last sync, only the columns of changed values need to be refreshed
+	quint32 Refresh = theAPI->GetProcessRefresh();
+	int Options = (bShow32 ? 0x01 : 0) | (m_bClearZeros ? 0x02 : 0) | (m_iUseDescr << 8);
+#ifdef WIN32
+	Options |= (HasExtProcInfo ? 0x04 : 0) | (IsMonitoringETW ? 0x08 : 0);
+#endif
+	bool bSyncAll = !m_bSyncValid || (Refresh & 1) != 0 || (Refresh != m_SyncedRefresh + 2 && Refresh != m_SyncedRefresh) || m_SyncedColumns != m_Columns || m_SyncedOptions != Options;
+	// Note: the cached cell texts were made with the old options, like clear zeros, hence all cells must be set again
+	bool bReformat = m_SyncedOptions != Options;
+
 	bool bGpuStats = m_Columns.contains(eGPU_History) || m_Columns.contains(eVMEM_History)
 		|| m_Columns.contains(eGPU_Usage) || m_Columns.contains(eGPU_Shared) || m_Columns.contains(eGPU_Dedicated) || m_Columns.contains(eGPU_Adapter);
 
@@ -100,13 +264,15 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 		
 		QHash<QVariant, STreeNode*>::iterator I = Old.find(ID);
 		SProcessNode* pNode = I != Old.end() ? static_cast<SProcessNode*>(I.value()) : NULL;
-		if(!pNode || (m_bTree ? !TestProcPath(pNode->Path, pProcess, ProcessList) : !pNode->Path.isEmpty()))
+		if(!pNode || pNode->UID != pProcess->GetUID() || (m_bTree ? !TestProcPath(pNode->Path, pProcess, ProcessList) : !pNode->Path.isEmpty()))
 		{
 			pNode = static_cast<SProcessNode*>(MkNode(ID));
 			pNode->Values.resize(columnCount());
+			pNode->IntValues.fill(0, columnCount());
 			if (m_bTree)
 				pNode->Path = MakeProcPath(pProcess, ProcessList);
 			pNode->pProcess = pProcess;
+			pNode->UID = pProcess->GetUID();
 			New[pNode->Path].append(pNode);
 			Added.insert(ID);
 		}
@@ -130,16 +296,6 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 		bool State = false;
 		int Changed = 0;
 
-		// Note: icons are loaded asynchroniusly
-		if (!pNode->Icon.isValid() && pModule)
-		{
-			QPixmap Icon = pModule->GetFileIcon();
-			if (!Icon.isNull()) {
-				Changed = 1; // set change for first column
-				pNode->Icon = Icon;
-			}
-		}
-
 
 		int RowColor = CTaskExplorer::eNone;
 #ifdef WIN32
@@ -181,8 +337,11 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 
 		pNode->Bold.clear();
 
-		SProcStats IoStats = pProcess->GetStats();
-		STaskStatsEx CpuStats = pProcess->GetCpuStats();
+		quint32 DirtyFields = (bSyncAll || !Index.isValid()) ? eProcessAll : pProcess->GetDirtyFields();
+
+		SProcessSample Sample = pProcess->GetSnapshot();
+		const SProcSample& IoStats = Sample.Stats;
+		const STaskSampleEx& CpuStats = Sample.Cpu;
 		SGpuStats GpuStats;
 		if (bGpuStats) // Note: GetGpuStats marks gpu stats to be keept updated, hence don't get it when its not needed
 			GpuStats = pProcess->GetGpuStats();
@@ -192,10 +351,17 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 			if (!m_Columns.contains(section))
 				continue; // ignore columns which are hidden
 
+			quint32 Fields = GetColumnFields(section);
+			bool bDirty = Fields == 0 || (DirtyFields & Fields) != 0;
+
+			// Note: numbers are taken as they are, only the other values go through a variant
 			quint64 CurIntValue = -1;
+			double RealValue = -1;
 
 			QVariant Value;
-			switch(section)
+			if (!bDirty)
+				CurIntValue = pNode->IntValues[section];
+			else switch(section)
 			{
 				case eProcess:
 				{
@@ -218,13 +384,13 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 					}
 											Value = Name; break;
 				}
-				case ePID:					Value = (qint64)pProcess->GetProcessId(); break;
+				case ePID:					Value = (qint64)Sample.ProcessId; break;
 				case eCPU_History:
-				case eCPU:					Value = CpuStats.CpuUsage; CurIntValue = 10000 * Value.toDouble(); break;
-				case eIO_History:			Value = qMax(IoStats.Disk.ReadRate.Get(), IoStats.Io.ReadRate.Get()) + qMax(IoStats.Disk.WriteRate.Get(), IoStats.Io.WriteRate.Get()) + IoStats.Io.OtherRate.Get(); break;
-				case eIO_TotalRate:			Value = CurIntValue = IoStats.Io.ReadRate.Get() + IoStats.Io.WriteRate.Get() + IoStats.Io.OtherRate.Get(); break;
+				case eCPU:					RealValue = CpuStats.CpuUsage; CurIntValue = 10000 * RealValue; break;
+				case eIO_History:			Value = qMax(IoStats.Disk.ReadRate, IoStats.Io.ReadRate) + qMax(IoStats.Disk.WriteRate, IoStats.Io.WriteRate) + IoStats.Io.OtherRate; break;
+				case eIO_TotalRate:			CurIntValue = IoStats.Io.ReadRate + IoStats.Io.WriteRate + IoStats.Io.OtherRate; break;
 				case eStaus:				Value = pProcess->GetStatusString(); break;
-				case ePrivateBytes:			Value = CurIntValue = CpuStats.PrivateBytesDelta.Value; break;
+				case ePrivateBytes:			CurIntValue = CpuStats.PrivateBytes; break;
 				case eUserName:				Value = pProcess->GetUserName(); break;
 #ifdef WIN32
 				case eServices:				Value = pWinProc->GetServiceList().join(tr(", ")); break;
@@ -236,49 +402,49 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 				case eGPU_History:			Value = GpuStats.GpuTimeUsage.Usage; break;
 				case eVMEM_History:			Value = qMax(GpuStats.GpuDedicatedUsage,GpuStats.GpuSharedUsage); break;
 
-				case eGPU_Usage:			Value = GpuStats.GpuTimeUsage.Usage; CurIntValue = 10000 * Value.toDouble(); break;
-				case eGPU_Shared:			Value = CurIntValue = GpuStats.GpuSharedUsage; break;
-				case eGPU_Dedicated:		Value = CurIntValue = GpuStats.GpuDedicatedUsage; break;
+				case eGPU_Usage:			RealValue = GpuStats.GpuTimeUsage.Usage; CurIntValue = 10000 * RealValue; break;
+				case eGPU_Shared:			CurIntValue = GpuStats.GpuSharedUsage; break;
+				case eGPU_Dedicated:		CurIntValue = GpuStats.GpuDedicatedUsage; break;
 				case eGPU_Adapter:			Value = GpuStats.GpuAdapter; break;
 
 				case eFileName:				Value = pProcess->GetFileName(); break;
 				case eCommandLine:			Value = pProcess->GetCommandLineStr(); break;
-				case ePeakPrivateBytes:		Value = CurIntValue = pProcess->GetPeakPrivateBytes(); break;
+				case ePeakPrivateBytes:		CurIntValue = Sample.PeakPrivateBytes; break;
 				case eMEM_History:
-				case eWorkingSet:			Value = CurIntValue = pProcess->GetWorkingSetSize(); break;
-				case ePeakWS:				Value = CurIntValue = pProcess->GetPeakWorkingSetSize(); break;
-				case ePrivateWS:			Value = CurIntValue = pProcess->GetPrivateWorkingSetSize(); break;
-				case eSharedWS:				Value = CurIntValue = pProcess->GetSharedWorkingSetSize(); break;
-				case eShareableWS:			Value = CurIntValue = pProcess->GetShareableWorkingSetSize(); break;
-				case eVirtualSize:			Value = CurIntValue = pProcess->GetVirtualSize(); break;
-				case ePeakVirtualSize:		Value = CurIntValue = pProcess->GetPeakVirtualSize(); break;
+				case eWorkingSet:			CurIntValue = Sample.WorkingSetSize; break;
+				case ePeakWS:				CurIntValue = Sample.PeakWorkingSetSize; break;
+				case ePrivateWS:			CurIntValue = Sample.PrivateWorkingSetSize; break;
+				case eSharedWS:				CurIntValue = pProcess->GetSharedWorkingSetSize(); break;
+				case eShareableWS:			CurIntValue = pProcess->GetShareableWorkingSetSize(); break;
+				case eVirtualSize:			CurIntValue = Sample.VirtualSize; break;
+				case ePeakVirtualSize:		CurIntValue = Sample.PeakVirtualSize; break;
 				case eSessionID:			Value = pProcess->GetSessionID(); break;
 				case eDebugTotal:			Value = pProcess->GetDebugMessageCount(); break;
-				case ePriorityClass:		Value = (quint32)pProcess->GetPriority(); break;
-				case eBasePriority:			Value = (quint32)pProcess->GetBasePriority(); break;
+				case ePriorityClass:		Value = (quint32)Sample.Priority; break;
+				case eBasePriority:			Value = (quint32)Sample.BasePriority; break;
 
-				case eThreads:				Value = CurIntValue = (quint32)pProcess->GetNumberOfThreads(); break;
-				case ePeakThreads:			Value = CurIntValue = (quint32)pProcess->GetPeakNumberOfThreads(); break;
-				case eHandles:				Value = CurIntValue = (quint32)pProcess->GetNumberOfHandles(); break;
-				case ePeakHandles:			Value = CurIntValue = (quint32)pProcess->GetPeakNumberOfHandles(); break;
+				case eThreads:				CurIntValue = (quint32)Sample.NumberOfThreads; break;
+				case ePeakThreads:			CurIntValue = (quint32)Sample.PeakNumberOfThreads; break;
+				case eHandles:				CurIntValue = (quint32)Sample.NumberOfHandles; break;
+				case ePeakHandles:			CurIntValue = (quint32)pProcess->GetPeakNumberOfHandles(); break;
 #ifdef WIN32
-				case eWND_Handles:			Value = CurIntValue = (quint32)pWinProc->GetWndHandles(); break;
-				case eGDI_Handles:			Value = CurIntValue = (quint32)pWinProc->GetGdiHandles(); break;
-				case eUSER_Handles:			Value = CurIntValue = (quint32)pWinProc->GetUserHandles(); break;
+				case eWND_Handles:			CurIntValue = (quint32)pWinProc->GetWndHandles(); break;
+				case eGDI_Handles:			CurIntValue = (quint32)pWinProc->GetGdiHandles(); break;
+				case eUSER_Handles:			CurIntValue = (quint32)pWinProc->GetUserHandles(); break;
 				case eIntegrity:			Value = pToken ? pToken->GetIntegrityLevel() : 0; break;
 #endif
-				case eIO_Priority:			Value = (quint32)pProcess->GetIOPriority(); break;
-				case ePagePriority:			Value = (quint32)pProcess->GetPagePriority(); break;
-				case eStartTime:			Value = pProcess->GetCreateTimeStamp(); break;
-				case eTotalCPU_Time:		Value = CurIntValue = (CpuStats.CpuKernelDelta.Value + CpuStats.CpuUserDelta.Value) / CPU_TIME_DIVIDER; break;
-				case eKernelCPU_Time:		Value = CurIntValue = CpuStats.CpuKernelDelta.Value / CPU_TIME_DIVIDER; break;
-				case eUserCPU_Time:			Value = CurIntValue = CpuStats.CpuUserDelta.Value / CPU_TIME_DIVIDER; break;
+				case eIO_Priority:			Value = (quint32)Sample.IOPriority; break;
+				case ePagePriority:			Value = (quint32)Sample.PagePriority; break;
+				case eStartTime:			Value = Sample.CreateTimeStamp; break;
+				case eTotalCPU_Time:		CurIntValue = (CpuStats.CpuKernelTime + CpuStats.CpuUserTime) / CPU_TIME_DIVIDER; break;
+				case eKernelCPU_Time:		CurIntValue = CpuStats.CpuKernelTime / CPU_TIME_DIVIDER; break;
+				case eUserCPU_Time:			CurIntValue = CpuStats.CpuUserTime / CPU_TIME_DIVIDER; break;
 #ifdef WIN32
 				case eVerificationStatus:	Value = pWinModule ? pWinModule->GetVerifyResultString() : ""; break;
 				case eVerifiedSigner:		Value = pWinModule ? pWinModule->GetVerifySignerName() : ""; break;
 				case eASLR:					Value = pWinModule ? pWinModule->GetASLRString() : ""; break;
 #endif
-				case eUpTime:				Value = pProcess->GetCreateTimeStamp() != 0 ? (curTime - pProcess->GetCreateTimeStamp() / 1000) : 0; break; // we must update the value to refresh the display
+				case eUpTime:				Value = Sample.CreateTimeStamp != 0 ? (curTime - Sample.CreateTimeStamp / 1000) : 0; break; // we must update the value to refresh the display
 				case eArch:					Value = pProcess->GetArchString(); break;
 #ifdef WIN32
 				case eElevation:			Value = pToken ? pToken->GetElevationString() : ""; break;
@@ -289,50 +455,50 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 				case eWindowTitle:			Value = pWinProc->GetWindowTitle();  break;
 				case eWindowStatus:			Value = pWinProc->GetWindowStatusString(); break;
 #endif
-				case eCycles:				Value = CurIntValue = CpuStats.CycleDelta.Value; break;
-				case eCyclesDelta:			Value = CurIntValue = CpuStats.CycleDelta.Delta; break;
+				case eCycles:				CurIntValue = CpuStats.Cycles; break;
+				case eCyclesDelta:			CurIntValue = CpuStats.CyclesDelta; break;
 #ifdef WIN32
 				case eDEP:					Value = pWinProc->GetDEPStatusString(); break;
 				case eVirtualized:			Value = pToken ? pToken->GetVirtualizationString() : ""; break;
 #endif
-				case eContextSwitches:		Value = CurIntValue = CpuStats.ContextSwitchesDelta.Value; break;
-				case eContextSwitchesDelta:	Value = CurIntValue = CpuStats.ContextSwitchesDelta.Delta; break;
-				case ePageFaults:			Value = CurIntValue = CpuStats.PageFaultsDelta.Value; break;
-				case ePageFaultsDelta:		Value = CurIntValue = CpuStats.PageFaultsDelta.Delta; break;
-				case eHardFaults:			Value = CurIntValue = CpuStats.HardFaultsDelta.Value; break;
-				case eHardFaultsDelta:		Value = CurIntValue = CpuStats.HardFaultsDelta.Delta; break;
+				case eContextSwitches:		CurIntValue = CpuStats.ContextSwitches; break;
+				case eContextSwitchesDelta:	CurIntValue = CpuStats.ContextSwitchesDelta; break;
+				case ePageFaults:			CurIntValue = CpuStats.PageFaults; break;
+				case ePageFaultsDelta:		CurIntValue = CpuStats.PageFaultsDelta; break;
+				case eHardFaults:			CurIntValue = CpuStats.HardFaults; break;
+				case eHardFaultsDelta:		CurIntValue = CpuStats.HardFaultsDelta; break;
 
 				// IO
-				case eIO_Reads:				Value = CurIntValue = IoStats.Io.ReadCount; break;
-				case eIO_Writes:			Value = CurIntValue = IoStats.Io.WriteCount; break;
-				case eIO_Other:				Value = CurIntValue = IoStats.Io.OtherCount; break;
-				case eIO_ReadBytes:			Value = CurIntValue = IoStats.Io.ReadRaw; break;
-				case eIO_WriteBytes:		Value = CurIntValue = IoStats.Io.WriteRaw; break;
-				case eIO_OtherBytes:		Value = CurIntValue = IoStats.Io.OtherRaw; break;
-				//case eIO_TotalBytes:		Value = CurIntValue = ; break;
-				case eIO_ReadsDelta:		Value = CurIntValue = IoStats.Io.ReadDelta.Delta; break;
-				case eIO_WritesDelta:		Value = CurIntValue = IoStats.Io.WriteDelta.Delta; break;
-				case eIO_OtherDelta:		Value = CurIntValue = IoStats.Io.OtherDelta.Delta; break;
-				//case eIO_TotalDelta:		Value = CurIntValue = ; break;
-				case eIO_ReadBytesDelta:	Value = CurIntValue = IoStats.Io.ReadRawDelta.Delta; break;
-				case eIO_WriteBytesDelta:	Value = CurIntValue = IoStats.Io.WriteRawDelta.Delta; break;
-				case eIO_OtherBytesDelta:	Value = CurIntValue = IoStats.Io.OtherRawDelta.Delta; break;
-				//case eIO_TotalBytesDelta:	Value = CurIntValue = ; break;
-				case eIO_ReadRate:			Value = CurIntValue = IoStats.Io.ReadRate.Get(); break;
-				case eIO_WriteRate:			Value = CurIntValue = IoStats.Io.WriteRate.Get(); break;
-				case eIO_OtherRate:			Value = CurIntValue = IoStats.Io.OtherRate.Get(); break;
-				//case eIO_TotalRate:		Value = CurIntValue = ; break;
+				case eIO_Reads:				CurIntValue = IoStats.Io.ReadCount; break;
+				case eIO_Writes:			CurIntValue = IoStats.Io.WriteCount; break;
+				case eIO_Other:				CurIntValue = IoStats.Io.OtherCount; break;
+				case eIO_ReadBytes:			CurIntValue = IoStats.Io.ReadRaw; break;
+				case eIO_WriteBytes:		CurIntValue = IoStats.Io.WriteRaw; break;
+				case eIO_OtherBytes:		CurIntValue = IoStats.Io.OtherRaw; break;
+				//case eIO_TotalBytes:		CurIntValue = ; break;
+				case eIO_ReadsDelta:		CurIntValue = IoStats.Io.ReadDelta; break;
+				case eIO_WritesDelta:		CurIntValue = IoStats.Io.WriteDelta; break;
+				case eIO_OtherDelta:		CurIntValue = IoStats.Io.OtherDelta; break;
+				//case eIO_TotalDelta:		CurIntValue = ; break;
+				case eIO_ReadBytesDelta:	CurIntValue = IoStats.Io.ReadRawDelta; break;
+				case eIO_WriteBytesDelta:	CurIntValue = IoStats.Io.WriteRawDelta; break;
+				case eIO_OtherBytesDelta:	CurIntValue = IoStats.Io.OtherRawDelta; break;
+				//case eIO_TotalBytesDelta:	CurIntValue = ; break;
+				case eIO_ReadRate:			CurIntValue = IoStats.Io.ReadRate; break;
+				case eIO_WriteRate:			CurIntValue = IoStats.Io.WriteRate; break;
+				case eIO_OtherRate:			CurIntValue = IoStats.Io.OtherRate; break;
+				//case eIO_TotalRate:		CurIntValue = ; break;
 
 #ifdef WIN32
 				case eOS_Context:			Value = (quint32)pWinProc->GetOsContextVersion(); break;
-				case ePagedPool:			Value = CurIntValue = pWinProc->GetPagedPool(); break;
-				case ePeakPagedPool:		Value = CurIntValue = pWinProc->GetPeakPagedPool(); break;
-				case eNonPagedPool:			Value = CurIntValue = pWinProc->GetNonPagedPool(); break;
-				case ePeakNonPagedPool:		Value = CurIntValue = pWinProc->GetPeakNonPagedPool(); break;
+				case ePagedPool:			CurIntValue = pWinProc->GetPagedPool(); break;
+				case ePeakPagedPool:		CurIntValue = pWinProc->GetPeakPagedPool(); break;
+				case eNonPagedPool:			CurIntValue = pWinProc->GetNonPagedPool(); break;
+				case ePeakNonPagedPool:		CurIntValue = pWinProc->GetPeakNonPagedPool(); break;
 #endif
 				case eMinimumWS:			Value = /*CurIntValue =*/ pProcess->GetMinimumWS(); break;
 				case eMaximumWS:			Value = /*CurIntValue =*/ pProcess->GetMaximumWS(); break;
-				case ePrivateBytesDelta:	Value = /*CurIntValue =*/ CpuStats.PrivateBytesDelta.Delta; break;
+				case ePrivateBytesDelta:	Value = /*CurIntValue =*/ CpuStats.PrivateBytesDelta; break;
 				case eSubsystem:			Value = (quint32)pProcess->GetSubsystem(); break;
 #ifdef WIN32
 				case ePackageName:			Value = pWinProc->GetPackageName(); break;
@@ -357,40 +523,43 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 
 				// Network IO
 				case eNET_History:
-				case eNet_TotalRate:		Value = CurIntValue = IoStats.Net.ReceiveRate.Get() + IoStats.Net.SendRate.Get(); break; 
-				case eNetUsage:				Value = pProcess->GetNetworkUsageFlags(); break;
-				case eReceives:				Value = CurIntValue = IoStats.Net.ReceiveCount; break; 
-				case eSends:				Value = CurIntValue = IoStats.Net.SendCount; break; 
-				case eReceiveBytes:			Value = CurIntValue = IoStats.Net.ReceiveRaw; break; 
-				case eSendBytes:			Value = CurIntValue = IoStats.Net.SendRaw; break; 
-				//case eTotalBytes:			Value = CurIntValue = ; break; 
-				case eReceivesDelta:		Value = CurIntValue = IoStats.Net.ReceiveDelta.Delta; break; 
-				case eSendsDelta:			Value = CurIntValue = IoStats.Net.SendDelta.Delta; break; 
-				case eReceiveBytesDelta:	Value = CurIntValue = IoStats.Net.ReceiveRawDelta.Delta; break; 
-				case eSendBytesDelta:		Value = CurIntValue = IoStats.Net.SendRawDelta.Delta; break; 
-				//case eTotalBytesDelta:	Value = CurIntValue = ; break; 
-				case eReceiveRate:			Value = CurIntValue = IoStats.Net.ReceiveRate.Get(); break; 
-				case eSendRate:				Value = CurIntValue = IoStats.Net.SendRate.Get(); break; 
+				case eNet_TotalRate:		CurIntValue = IoStats.Net.ReceiveRate + IoStats.Net.SendRate; break; 
+				case eNetUsage:				Value = Sample.NetworkUsageFlags; break;
+				case eReceives:				CurIntValue = IoStats.Net.ReceiveCount; break; 
+				case eSends:				CurIntValue = IoStats.Net.SendCount; break; 
+				case eReceiveBytes:			CurIntValue = IoStats.Net.ReceiveRaw; break; 
+				case eSendBytes:			CurIntValue = IoStats.Net.SendRaw; break; 
+				//case eTotalBytes:			CurIntValue = ; break; 
+				case eReceivesDelta:		CurIntValue = IoStats.Net.ReceiveDelta; break; 
+				case eSendsDelta:			CurIntValue = IoStats.Net.SendDelta; break; 
+				case eReceiveBytesDelta:	CurIntValue = IoStats.Net.ReceiveRawDelta; break; 
+				case eSendBytesDelta:		CurIntValue = IoStats.Net.SendRawDelta; break; 
+				//case eTotalBytesDelta:	CurIntValue = ; break; 
+				case eReceiveRate:			CurIntValue = IoStats.Net.ReceiveRate; break; 
+				case eSendRate:				CurIntValue = IoStats.Net.SendRate; break; 
 
 				// Disk IO
-				case eDisk_TotalRate:		Value = CurIntValue = IoStats.Disk.ReadRate.Get() + IoStats.Disk.WriteRate.Get(); break; 
-				case eReads:				Value = CurIntValue = IoStats.Disk.ReadCount; break;
-				case eWrites:				Value = CurIntValue = IoStats.Disk.WriteCount; break;
-				case eReadBytes:			Value = CurIntValue = IoStats.Disk.ReadRaw; break;
-				case eWriteBytes:			Value = CurIntValue = IoStats.Disk.WriteRaw; break;
-				//case eTotalBytes:			Value = CurIntValue = ; break;
-				case eReadsDelta:			Value = CurIntValue = IoStats.Disk.ReadDelta.Delta; break;
-				case eWritesDelta:			Value = CurIntValue = IoStats.Disk.WriteDelta.Delta; break;
-				case eReadBytesDelta:		Value = CurIntValue = IoStats.Disk.ReadRawDelta.Delta; break;
-				case eWriteBytesDelta:		Value = CurIntValue = IoStats.Disk.WriteRawDelta.Delta; break;
-				//case eTotalBytesDelta:	Value = CurIntValue = ; break;
-				case eReadRate:				Value = CurIntValue = IoStats.Disk.ReadRate.Get(); break;
-				case eWriteRate:			Value = CurIntValue = IoStats.Disk.WriteRate.Get(); break;
+				case eDisk_TotalRate:		CurIntValue = IoStats.Disk.ReadRate + IoStats.Disk.WriteRate; break; 
+				case eReads:				CurIntValue = IoStats.Disk.ReadCount; break;
+				case eWrites:				CurIntValue = IoStats.Disk.WriteCount; break;
+				case eReadBytes:			CurIntValue = IoStats.Disk.ReadRaw; break;
+				case eWriteBytes:			CurIntValue = IoStats.Disk.WriteRaw; break;
+				//case eTotalBytes:			CurIntValue = ; break;
+				case eReadsDelta:			CurIntValue = IoStats.Disk.ReadDelta; break;
+				case eWritesDelta:			CurIntValue = IoStats.Disk.WriteDelta; break;
+				case eReadBytesDelta:		CurIntValue = IoStats.Disk.ReadRawDelta; break;
+				case eWriteBytesDelta:		CurIntValue = IoStats.Disk.WriteRawDelta; break;
+				//case eTotalBytesDelta:	CurIntValue = ; break;
+				case eReadRate:				CurIntValue = IoStats.Disk.ReadRate; break;
+				case eWriteRate:			CurIntValue = IoStats.Disk.WriteRate; break;
 			}
 
 			SProcessNode::SValue& ColValue = pNode->Values[section];
 
 			bool bChanged = false;
+			if (!bDirty)
+				; // the value is the same as on the last sync
+			else
 #ifdef WIN32
 			if (!IsMonitoringETW // Note: this columns are not available without ETW being enabled
 			 && (section == eNET_History || (section >= eNet_TotalRate && section <= eSendRate)
@@ -401,139 +570,52 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 			if (CurIntValue == -1)
 			{
 				CurIntValue = 0;
-				bChanged = (ColValue.Raw != Value);
+				if (section == eStaus) // the status is sorted by the row color, not by its text
+					bChanged = (ColValue.Raw != SortKey || ColValue.Formated.Get() != Value.toString());
+				else
+					bChanged = (ColValue.Raw != Value);
 			}
-			else if (ColValue.Raw.isNull())
+			else if (!ColValue.IsNumber())
 				bChanged = true;
 			else // if the change is less than 0.01%, i.e. in unit notation the difference will be not displayed, dont issue an update
 			{
 				// Note: this savec 20% of CPU load in the debug build
 
-				quint64 OldIntValue;
-				switch (section)
-				{
-					case eCPU:
-					case eGPU_Usage:
-						OldIntValue = ColValue.Raw.toDouble() * 10000; 
-						break;
-					default:
-						OldIntValue = ColValue.Raw.toULongLong();
-				}
-				
+				quint64 OldIntValue = RealValue != -1 ? ColValue.Raw.toDouble() * 10000 : ColValue.Raw.toULongLong();
+
 				if (CurIntValue > OldIntValue)
 					bChanged = (10000 * (CurIntValue - OldIntValue) / CurIntValue) > 0;
 				else if (OldIntValue > CurIntValue)
 					bChanged = (10000 * (OldIntValue - CurIntValue) / OldIntValue) > 0;
 			}
 
+			if (bReformat && bDirty)
+				bChanged = true;
+
 			if (bChanged)
 			{
 				if(Changed == 0)
 					Changed = 1;
-				ColValue.Raw = Value;
 
-				switch(section)
+				if (RealValue != -1)
+					ColValue.SetNumber(RealValue);
+				else if (!Value.isValid())
+					ColValue.SetNumber(CurIntValue);
+				else if (section == eStaus)
 				{
-					case ePID:				if (Value.toLongLong() < 0) ColValue.Formated = ""; break;
-
-					case eCPU:
-					case eGPU_Usage:
-											ColValue.Formated = (!bClearZeros || Value.toDouble() > 0.00004) ? QString::number(Value.toDouble()*100, 10, 2) + "%" : ""; break;
-
-					case eStaus:			ColValue.SortKey = SortKey;	break;
-
-					case ePrivateBytes:		
-					case ePeakPrivateBytes:
-					case eWorkingSet:
-					case ePeakWS:
-					case ePrivateWS:
-					case eSharedWS:
-					case eShareableWS:
-					case eVirtualSize:
-					case ePeakVirtualSize:
-#ifdef WIN32
-					case ePagedPool:
-					case ePeakPagedPool:
-					case eNonPagedPool:
-					case ePeakNonPagedPool:
-#endif
-					case eMinimumWS:
-					case eMaximumWS:
-
-					case eFileSize:
-											ColValue.Formated = FormatSize(Value.toULongLong()); break;
-
-					// since not all programs use GPU memory, make this value clearable
-					case eGPU_Dedicated:
-					case eGPU_Shared:
-											ColValue.Formated = FormatSizeEx(Value.toULongLong(), bClearZeros); break;
-
-					case ePrivateBytesDelta:
-					{
-						qint64 iDelta = Value.toLongLong();
-						if (iDelta < 0)
-							ColValue.Formated = "-" + FormatSize(iDelta * -1);
-						else if (iDelta > 0)
-							ColValue.Formated = "+" + FormatSize(iDelta);
-						else if (bClearZeros)
-							ColValue.Formated = QString();
-						else
-							ColValue.Formated = "0";
-						break;
-					}
-
-					case eCycles:
-					case eContextSwitches:
-					case ePageFaults:
-					case eHardFaults:
-					case eIO_Reads:
-					case eIO_Writes:
-					case eIO_Other:
-					case eReceives:
-					case eSends:
-					case eReads:
-					case eWrites:
-										ColValue.Formated = FormatNumber(Value.toULongLong()); break;
-
-#ifdef WIN32
-					// since not all programs use GUI resources, make this value clearable
-					case eWND_Handles:
-					case eGDI_Handles:
-					case eUSER_Handles:
-					case eHangCount:
-					case eGhostCount:
-#endif
-
-					case eCyclesDelta:
-					case eContextSwitchesDelta:
-					case ePageFaultsDelta:
-					case eHardFaultsDelta:
-					case eIO_ReadsDelta:
-					case eIO_WritesDelta:
-					case eIO_OtherDelta:
-					case eReceivesDelta:
-					case eSendsDelta:
-					case eReadsDelta:
-					case eWritesDelta:
-											ColValue.Formated = FormatNumberEx(Value.toULongLong(), bClearZeros); break;
-
-					case eStartTime:		ColValue.Formated = QDateTime::fromTime_t(Value.toULongLong()/1000).toString("dd.MM.yyyy hh:mm:ss"); break;
-#ifdef WIN32
-					case eTimeStamp:
-#endif
-					case eFileModifiedTime:
-											if (Value.toULongLong() != 0) ColValue.Formated = QDateTime::fromTime_t(Value.toULongLong()).toString("dd.MM.yyyy hh:mm:ss"); break;
-                    case eUpTime:
-#ifdef WIN32
-					case eRunningTime:			
-					case eSuspendedTime:
-#endif
-											ColValue.Formated = (Value.toULongLong() == 0) ? QString() : FormatTime(Value.toULongLong()); break;
-					case eTotalCPU_Time:
-					case eKernelCPU_Time:
-					case eUserCPU_Time:
-											ColValue.Formated = FormatTime(Value.toULongLong()); break;
+					ColValue.SetNumber(SortKey);
+					ColValue.Formated = Value.toString();
+				}
+				else
+				{
+					// Note: plain numbers get their text only when they are displayed, see FormatCell
+					ColValue.Raw = Value;
+					ColValue.Formated.Clear();
+				}
 
+				// the values which have a text of their own
+				switch(section)
+				{
 					case ePriorityClass:	ColValue.Formated = pProcess->GetPriorityString(); break;
 					case eBasePriority:		ColValue.Formated = pProcess->GetBasePriorityString(); break;
 					case ePagePriority:		ColValue.Formated = pProcess->GetPagePriorityString(); break;
@@ -549,45 +631,11 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 					case eOS_Context:		ColValue.Formated = pWinProc->GetOsContextString(); break;
 #endif
 					case eNetUsage:			ColValue.Formated = pProcess->GetNetworkUsageString(); break;
-
-					case eIO_ReadBytes:
-					case eIO_WriteBytes:
-					case eIO_OtherBytes:
-
-					case eReceiveBytes:
-					case eSendBytes:
-
-					case eReadBytes:
-					case eWriteBytes:
-												if(Value.type() != QVariant::String) ColValue.Formated = FormatSize(Value.toULongLong()); break; 
-
-					case eIO_ReadBytesDelta:
-					case eIO_WriteBytesDelta:
-					case eIO_OtherBytesDelta:
-
-					case eReceiveBytesDelta:
-					case eSendBytesDelta:
-
-					case eReadBytesDelta:
-					case eWriteBytesDelta:
-												if(Value.type() != QVariant::String) ColValue.Formated = FormatSizeEx(Value.toULongLong(), bClearZeros); break; 
-
-					case eIO_TotalRate:
-					case eIO_ReadRate:
-					case eIO_WriteRate:
-					case eIO_OtherRate:
-					case eReceiveRate:
-					case eSendRate:
-					case eNet_TotalRate:
-					case eReadRate:
-					case eWriteRate:
-					case eDisk_TotalRate:
-												if(Value.type() != QVariant::String) ColValue.Formated = FormatRateEx(Value.toULongLong(), bClearZeros); break; 
-
-
 				}
 			}
 
+			if (bDirty)
+				pNode->IntValues[section] = CurIntValue;
 
 			if(!Highlights.isEmpty() && CurIntValue != 0)
 			{
@@ -636,6 +684,20 @@ QSet<quint64> CProcessModel::Sync(QMap<quint64, CProcessPtr> ProcessList)
 		}
 	}
 
+	// Note: if the process list was updated while we were syncing we may have seen a mix of two updates, so do a full sync next time
+	m_bSyncValid = theAPI->GetProcessRefresh() == Refresh;
+	m_SyncedRefresh = Refresh;
+	if (m_SyncedColumns != m_Columns)
+	{
+		// tell the collectors which optional values we need, hidden columns should not cost anything
+		quint32 Demand = 0;
+		foreach(int section, m_Columns)
+			Demand |= GetColumnDemand(section);
+		theAPI->SetProcessDemand(this, Demand);
+	}
+	m_SyncedColumns = m_Columns;
+	m_SyncedOptions = Options;
+
 	CTreeItemModel::Sync(New, Old);
 
 	//for (QMap<QList<QVariant>, QList<STreeNode*> >::const_iterator I = New.begin(); I != New.end(); I++)
@@ -656,6 +718,22 @@ QVariant CProcessModel::NodeData(STreeNode* pNode, int role, int section) const
 {
     switch(role)
 	{
+		case Qt::DecorationRole:
+		{
+			if (m_bUseIcons && section == eProcess)
+			{
+				// Note: icons are loaded asynchroniusly, if its not ready yet the view gets updated by OnIconsReady
+				CModulePtr pModule = static_cast<SProcessNode*>(pNode)->pProcess->GetModuleInfo();
+				QPixmap Icon = pModule ? pModule->GetFileIcon() : QPixmap();
+				if (Icon.isNull())
+				{
+					m_PendingIcons.insert(pNode->ID);
+					return GetDefaultIcon();
+				}
+				return QVariant(Icon);
+			}
+			break;
+		}
 		case Qt::FontRole:
 		{
 			SProcessNode* pProcessNode = static_cast<SProcessNode*>(pNode);
@@ -672,6 +750,160 @@ QVariant CProcessModel::NodeData(STreeNode* pNode, int role, int section) const
 	return CTreeItemModel::NodeData(pNode, role, section);
 }
 
+QString CProcessModel::FormatCell(STreeNode* pNode, int section) const
+{
+	const QVariant& Value = pNode->Values[section].Raw;
+	switch(section)
+	{
+		case ePID:				if (Value.toLongLong() < 0) return ""; break;
+
+		case eCPU:
+		case eGPU_Usage:
+								return (!m_bClearZeros || Value.toDouble() > 0.00004) ? QString::number(Value.toDouble()*100, 10, 2) + "%" : "";
+
+		case ePrivateBytes:		
+		case ePeakPrivateBytes:
+		case eWorkingSet:
+		case ePeakWS:
+		case ePrivateWS:
+		case eSharedWS:
+		case eShareableWS:
+		case eVirtualSize:
+		case ePeakVirtualSize:
+#ifdef WIN32
+		case ePagedPool:
+		case ePeakPagedPool:
+		case eNonPagedPool:
+		case ePeakNonPagedPool:
+#endif
+		case eMinimumWS:
+		case eMaximumWS:
+
+		case eFileSize:
+								return FormatSize(Value.toULongLong());
+
+		// since not all programs use GPU memory, make this value clearable
+		case eGPU_Dedicated:
+		case eGPU_Shared:
+								return FormatSizeEx(Value.toULongLong(), m_bClearZeros);
+
+		case ePrivateBytesDelta:
+		{
+			qint64 iDelta = Value.toLongLong();
+			if (iDelta < 0)
+				return "-" + FormatSize(iDelta * -1);
+			else if (iDelta > 0)
+				return "+" + FormatSize(iDelta);
+			else if (m_bClearZeros)
+				return "";
+			return "0";
+		}
+
+		case eCycles:
+		case eContextSwitches:
+		case ePageFaults:
+		case eHardFaults:
+		case eIO_Reads:
+		case eIO_Writes:
+		case eIO_Other:
+		case eReceives:
+		case eSends:
+		case eReads:
+		case eWrites:
+								return FormatNumber(Value.toULongLong());
+
+#ifdef WIN32
+		// since not all programs use GUI resources, make this value clearable
+		case eWND_Handles:
+		case eGDI_Handles:
+		case eUSER_Handles:
+		case eHangCount:
+		case eGhostCount:
+#endif
+
+		case eCyclesDelta:
+		case eContextSwitchesDelta:
+		case ePageFaultsDelta:
+		case eHardFaultsDelta:
+		case eIO_ReadsDelta:
+		case eIO_WritesDelta:
+		case eIO_OtherDelta:
+		case eReceivesDelta:
+		case eSendsDelta:
+		case eReadsDelta:
+		case eWritesDelta:
+								return FormatNumberEx(Value.toULongLong(), m_bClearZeros);
+
+		case eStartTime:		return QDateTime::fromTime_t(Value.toULongLong()/1000).toString("dd.MM.yyyy hh:mm:ss");
+#ifdef WIN32
+		case eTimeStamp:
+#endif
+		case eFileModifiedTime:
+								if (Value.toULongLong() != 0) return QDateTime::fromTime_t(Value.toULongLong()).toString("dd.MM.yyyy hh:mm:ss"); break;
+		case eUpTime:
+#ifdef WIN32
+		case eRunningTime:			
+		case eSuspendedTime:
+#endif
+								return (Value.toULongLong() == 0) ? QString("") : FormatTime(Value.toULongLong());
+		case eTotalCPU_Time:
+		case eKernelCPU_Time:
+		case eUserCPU_Time:
+								return FormatTime(Value.toULongLong());
+
+		case eIO_ReadBytes:
+		case eIO_WriteBytes:
+		case eIO_OtherBytes:
+
+		case eReceiveBytes:
+		case eSendBytes:
+
+		case eReadBytes:
+		case eWriteBytes:
+								return FormatSize(Value.toULongLong());
+
+		case eIO_ReadBytesDelta:
+		case eIO_WriteBytesDelta:
+		case eIO_OtherBytesDelta:
+
+		case eReceiveBytesDelta:
+		case eSendBytesDelta:
+
+		case eReadBytesDelta:
+		case eWriteBytesDelta:
+								return FormatSizeEx(Value.toULongLong(), m_bClearZeros);
+
+		case eIO_TotalRate:
+		case eIO_ReadRate:
+		case eIO_WriteRate:
+		case eIO_OtherRate:
+		case eReceiveRate:
+		case eSendRate:
+		case eNet_TotalRate:
+		case eReadRate:
+		case eWriteRate:
+		case eDisk_TotalRate:
+								return FormatRateEx(Value.toULongLong(), m_bClearZeros);
+	}
+	return QString();
+}
+
+void CProcessModel::OnIconsReady()
+{
+	// Note: only the rows which were shown with the default icon need a repaint, in tree mode they may be at any depth,
+	//			rows whose file has no icon at all ask for it again and get back into the set
+	QSet<QVariant> PendingIcons;
+	PendingIcons.swap(m_PendingIcons);
+	foreach(const QVariant& ID, PendingIcons)
+	{
+		STreeNode* pNode = m_Map.value(ID);
+		if (!pNode)
+			continue; // the row is gone in the mean time
+		QModelIndex Index = createIndex(pNode->Row, eProcess, pNode);
+		emit dataChanged(Index, Index, QVector<int>() << Qt::DecorationRole);
+	}
+}
+
 CProcessPtr CProcessModel::GetProcess(const QModelIndex &index) const
 {
 	if (!index.isValid())
@@ -683,6 +915,17 @@ CProcessPtr CProcessModel::GetProcess(const QModelIndex &index) const
 	return pNode->pProcess;
 }
 
+SProcessUID CProcessModel::GetProcessUID(const QModelIndex &index) const
+{
+	if (!index.isValid())
+        return SProcessUID();
+
+	SProcessNode* pNode = static_cast<SProcessNode*>(index.internalPointer());
+	ASSERT(pNode);
+
+	return pNode->UID;
+}
+
 int CProcessModel::columnCount(const QModelIndex &parent) const
 {
 	return eCount;
@@ -16,6 +16,7 @@ public:
 	QSet<quint64>	Sync(QMap<quint64, CProcessPtr> ProcessList);
 
 	CProcessPtr		GetProcess(const QModelIndex &index) const;
+	SProcessUID		GetProcessUID(const QModelIndex &index) const;
 
     int				columnCount(const QModelIndex &parent = QModelIndex()) const;
     QVariant		headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
@@ -209,19 +210,28 @@ public:
 		eCount
 	};
 
+protected slots:
+	void					OnIconsReady();
+
 protected:
 	struct SProcessNode: STreeNode
 	{
 		SProcessNode(const QVariant& Id) : STreeNode(Id), iColor(0) { }
 
 		CProcessPtr			pProcess;
+		SProcessUID			UID; // a reused pid gets a new node
 
 		int					iColor;
 
 		QSet<int>			Bold;
+		QVector<quint64>	IntValues; // the last CurIntValue of every column, used for columns which did not change
 	};
 
 	virtual QVariant		NodeData(STreeNode* pNode, int role, int section) const;
+	virtual QString			FormatCell(STreeNode* pNode, int section) const;
+
+	static quint32			GetColumnFields(int section);
+	static quint32			GetColumnDemand(int section);
 
 	virtual STreeNode*		MkNode(const QVariant& Id) { return new SProcessNode(Id); }
 		
@@ -229,6 +239,15 @@ protected:
 	bool					TestProcPath(const QList<QVariant>& Path, const CProcessPtr& pProcess, const QMap<quint64, CProcessPtr>& ProcessList, int Index = 0);
 	
 	int						m_iUseDescr;
+	bool					m_bClearZeros;
+
+	// the state of the last sync, if anything besides the process values changed we must do a full sync
+	quint32					m_SyncedRefresh;
+	bool					m_bSyncValid;
+	QSet<int>				m_SyncedColumns;
+	int						m_SyncedOptions;
+
+	mutable QSet<QVariant>	m_PendingIcons; // rows shown with the default icon, see OnIconsReady
 
 	virtual QVariant GetDefaultIcon() const;
 };
\ No newline at end of file
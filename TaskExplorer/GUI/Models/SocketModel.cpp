@@ -5,6 +5,8 @@
 #ifdef WIN32
 #include "../../API/Windows/WinSocket.h"
 #include "../../API/Windows/WindowsAPI.h"
+#else
+#include "../../API/Linux/LinuxSocket.h"
 #endif
 
 CSocketModel::CSocketModel(QObject *parent)
@@ -54,7 +56,9 @@ void CSocketModel::Sync(QMultiMap<quint64, CSocketPtr> SocketList)
 		}
 
 #ifdef WIN32
-		CWinSocket* pWinSock = qobject_cast<CWinSocket*>(pSocket.data());
+		CWinSocket* pWinSock = static_cast<CWinSocket*>(pSocket.data());
+#else
+		CLinuxSocket* pLinuxSock = static_cast<CLinuxSocket*>(pSocket.data());
 #endif
 
 		int Col = 0;
@@ -88,7 +92,8 @@ void CSocketModel::Sync(QMultiMap<quint64, CSocketPtr> SocketList)
 		}
 
 
-		SSockStats Stats = pSocket->GetStats();
+		SSocketSample Sample = pSocket->GetSnapshot();
+		const SNetSample& Net = Sample.Net;
 
 		for(int section = 0; section < columnCount(); section++)
 		{
@@ -99,34 +104,43 @@ void CSocketModel::Sync(QMultiMap<quint64, CSocketPtr> SocketList)
 			switch(section)
 			{
 				case eProcess:			Value = pSocket->GetProcessName(); break;
-				case eProtocol:			Value = (quint32)pSocket->GetProtocolType(); break; 
-				case eState:			Value = (quint32)pSocket->GetState(); break; 
+				case eProtocol:			Value = Sample.ProtocolType; break; 
+				case eState:			Value = Sample.State; break; 
+#ifdef WIN32
 				case eLocalAddress:		Value = pSocket->GetLocalAddress().toString(); break;
-				case eLocalPort:		Value = pSocket->GetLocalPort(); break; 
+#else
+				case eLocalAddress:		Value = Sample.ProtocolType == NET_TYPE_UNIX ? pLinuxSock->GetPath() : pSocket->GetLocalAddress().toString(); break;
+#endif
+				case eLocalPort:		Value = Sample.LocalPort; break; 
 				case eRemoteAddress:	Value = pSocket->GetRemoteAddress().toString(); break; 
-				case eRemotePort:		Value = pSocket->GetRemotePort(); break; 
+				case eRemotePort:		Value = Sample.RemotePort; break; 
 #ifdef WIN32
 				case eOwnerService:		Value = pWinSock->GetOwnerServiceName(); break; 
 #endif
-				case eTimeStamp:		Value = pSocket->GetCreateTimeStamp(); break;
+				case eTimeStamp:		Value = Sample.CreateTimeStamp; break;
 				//case eLocalHostname:	Value = ; break; 
 				case eRemoteHostname:	Value = pSocket->GetRemoteHostName(); break; 
 
-				case eReceives:			Value = Stats.Net.ReceiveCount; break; 
-				case eSends:			Value = Stats.Net.SendCount; break; 
-				case eReceiveBytes:		Value = Stats.Net.ReceiveRaw; break; 
-				case eSendBytes:		Value = Stats.Net.SendRaw; break; 
+				case eReceives:			Value = Net.ReceiveCount; break; 
+				case eSends:			Value = Net.SendCount; break; 
+				case eReceiveBytes:		Value = Net.ReceiveRaw; break; 
+				case eSendBytes:		Value = Net.SendRaw; break; 
 				//case eTotalBytes:		Value = ; break; 
-				case eReceivesDelta:	Value = Stats.Net.ReceiveDelta.Delta; break; 
-				case eSendsDelta:		Value = Stats.Net.SendDelta.Delta; break; 
-				case eReceiveBytesDelta:Value = Stats.Net.ReceiveRawDelta.Delta; break; 
-				case eSendBytesDelta:	Value = Stats.Net.SendRawDelta.Delta; break; 
+				case eReceivesDelta:	Value = Net.ReceiveDelta; break; 
+				case eSendsDelta:		Value = Net.SendDelta; break; 
+				case eReceiveBytesDelta:Value = Net.ReceiveRawDelta; break; 
+				case eSendBytesDelta:	Value = Net.SendRawDelta; break; 
 				//case eTotalBytesDelta:	Value = ; break; 
-				case eReceiveRate:		Value = Stats.Net.ReceiveRate.Get(); break; 
-				case eSendRate:			Value = Stats.Net.SendRate.Get(); break; 
+				case eReceiveRate:		Value = Net.ReceiveRate; break; 
+				case eSendRate:			Value = Net.SendRate; break; 
 				//case eTotalRate:		Value = ; break; 
 #ifdef WIN32
 				case eFirewallStatus:	Value = pWinSock->GetFirewallStatus(); break; 
+#else
+				case eRoundTripTime:	Value = pLinuxSock->HasTcpInfo() ? pLinuxSock->GetRoundTripTime() : QVariant(); break;
+				case eRoundTripTimeVar:	Value = pLinuxSock->HasTcpInfo() ? pLinuxSock->GetRoundTripTimeVar() : QVariant(); break;
+				case eRetransmissions:	Value = pLinuxSock->HasTcpInfo() ? pLinuxSock->GetRetransmissions() : QVariant(); break;
+				case eCongestionWindow:	Value = pLinuxSock->HasTcpInfo() ? pLinuxSock->GetCongestionWindow() : QVariant(); break;
 #endif
 			}
 
@@ -177,6 +191,12 @@ void CSocketModel::Sync(QMultiMap<quint64, CSocketPtr> SocketList)
 												if(Value.type() != QVariant::String) ColValue.Formated = FormatNumberEx(Value.toULongLong(), bClearZeros); break; 
 #ifdef WIN32
 					case eFirewallStatus:		ColValue.Formated = pWinSock->GetFirewallStatusString(); break; 
+#else
+					case eRoundTripTime:
+					case eRoundTripTimeVar:
+												if(Value.isValid()) ColValue.Formated = tr("%1 ms").arg(Value.toUInt() / 1000.0, 0, 'f', 1); break;
+					case eRetransmissions:
+												if(Value.isValid()) ColValue.Formated = FormatNumber(Value.toULongLong()); break;
 #endif
 												
 				}
@@ -245,6 +265,11 @@ QVariant CSocketModel::headerData(int section, Qt::Orientation orientation, int
 			//case eTotalBytesDelta:	return tr("Total bytes delta");
 #ifdef WIN32
 			case eFirewallStatus:	return tr("Firewall status");
+#else
+			case eRoundTripTime:	return tr("RTT");
+			case eRoundTripTimeVar:	return tr("RTT variance");
+			case eRetransmissions:	return tr("Retransmissions");
+			case eCongestionWindow:	return tr("Congestion window");
 #endif
 			case eReceiveRate:		return tr("Receive rate");
 			case eSendRate:			return tr("Send rate");
@@ -50,6 +50,11 @@ public:
 		//eTotalRate,
 #ifdef WIN32
 		eFirewallStatus,
+#else
+		eRoundTripTime,
+		eRoundTripTimeVar,
+		eRetransmissions,
+		eCongestionWindow,
 #endif
 		//eLocalHostname,
 		eRemoteHostname,
@@ -73,4 +78,4 @@ protected:
 	
 
 	virtual QVariant GetDefaultIcon() const;
-};
\ No newline at end of file
+};
\ No newline at end of file
@@ -87,7 +87,8 @@ void CThreadModel::Sync(QMap<quint64, CThreadPtr> ThreadList)
 			Changed = 2;
 		}
 
-		STaskStats CpuStats = pThread->GetCpuStats();
+		SThreadSample Sample = pThread->GetSnapshot();
+		const STaskSample& CpuStats = Sample.Cpu;
 
 		for(int section = 0; section < columnCount(); section++)
 		{
@@ -97,7 +98,7 @@ void CThreadModel::Sync(QMap<quint64, CThreadPtr> ThreadList)
 			QVariant Value;
 			switch(section)
 			{
-				case eThread:				Value = pThread->GetThreadId(); break;
+				case eThread:				Value = Sample.ThreadId; break;
 				case eCPU_History:
 				case eCPU:					Value = CpuStats.CpuUsage; break;
 #ifdef WIN32
@@ -106,21 +107,21 @@ void CThreadModel::Sync(QMap<quint64, CThreadPtr> ThreadList)
 				case eName:					Value = pWinThread->GetThreadName(); break;
 				case eType:					Value = pWinThread->IsMainThread() ? 2 : pWinThread->IsGuiThread() ? 1 : 0; break;
 #endif
-				case eCreated:				Value = pThread->GetCreateTimeStamp(); break;
+				case eCreated:				Value = Sample.CreateTimeStamp; break;
 #ifdef WIN32
 				case eStartModule:			Value = pWinThread->GetStartAddressFileName(); break;
 #endif
-				case eContextSwitches:		Value = CpuStats.ContextSwitchesDelta.Value; break;
-				case eContextSwitchesDelta:	Value = CpuStats.ContextSwitchesDelta.Delta; break;
-                case ePriority:				Value = (quint32)pThread->GetPriority(); break;
-                case eBasePriority:			Value = (quint32)pThread->GetBasePriority(); break;
-                case ePagePriority:			Value = (quint32)pThread->GetPagePriority(); break;
-                case eIOPriority:			Value = (quint32)pThread->GetIOPriority(); break;
-				case eCycles:				Value = CpuStats.CycleDelta.Value; break;
-				case eCyclesDelta:			Value = CpuStats.CycleDelta.Delta; break;
-				case eState:				Value = pThread->GetWaitState(); break;
-				case eKernelTime:			Value = CpuStats.CpuKernelDelta.Value;
-				case eUserTime:				Value = CpuStats.CpuUserDelta.Value;
+				case eContextSwitches:		Value = CpuStats.ContextSwitches; break;
+				case eContextSwitchesDelta:	Value = CpuStats.ContextSwitchesDelta; break;
+                case ePriority:				Value = (quint32)Sample.Priority; break;
+                case eBasePriority:			Value = (quint32)Sample.BasePriority; break;
+                case ePagePriority:			Value = (quint32)Sample.PagePriority; break;
+                case eIOPriority:			Value = (quint32)Sample.IOPriority; break;
+				case eCycles:				Value = CpuStats.Cycles; break;
+				case eCyclesDelta:			Value = CpuStats.CyclesDelta; break;
+				case eState:				Value = (quint64)Sample.State | ((quint64)Sample.WaitReason << 32); break;
+				case eKernelTime:			Value = CpuStats.CpuKernelTime;
+				case eUserTime:				Value = CpuStats.CpuUserTime;
 #ifdef WIN32
 				case eIdealProcessor:		Value = pWinThread->GetIdealProcessor(); break;
 				case eHasToken:				Value = pWinThread->HasToken(); break;
@@ -59,6 +59,17 @@ CProcessTree::CProcessTree(QWidget *parent)
 	m_pProcessList->GetView()->setItemDelegate(theGUI->GetItemDelegate());
 	m_pProcessList->GetTree()->setItemDelegate(theGUI->GetItemDelegate());
 
+	// the graph columns are painted from the sample history kept by the delegate, only the visible cells cost anything
+	m_pHistoryDelegate = new CHistoryDelegate(theGUI->GetItemDelegate(), this);
+	m_pHistoryDelegate->AddColumn(CProcessModel::eCPU_History, QList<QColor>() << Qt::green << Qt::red);
+	m_pHistoryDelegate->AddColumn(CProcessModel::eMEM_History, QList<QColor>() << QColor("#CCFF33"));
+	m_pHistoryDelegate->AddColumn(CProcessModel::eIO_History, QList<QColor>() << Qt::green << Qt::red << Qt::blue);
+	m_pHistoryDelegate->AddColumn(CProcessModel::eNET_History, QList<QColor>() << Qt::green << Qt::red);
+	m_pHistoryDelegate->AddColumn(CProcessModel::eGPU_History, QList<QColor>() << Qt::green);
+	m_pHistoryDelegate->AddColumn(CProcessModel::eVMEM_History, QList<QColor>() << QColor("#CCFF33"));
+	for (int i = CProcessModel::eCPU_History; i <= CProcessModel::eVMEM_History; i++)
+		m_pProcessList->GetView()->setItemDelegateForColumn(i, m_pHistoryDelegate);
+
 	connect(m_pProcessModel, SIGNAL(ToolTipCallback(const QVariant&, QString&)), this, SLOT(OnToolTipCallback(const QVariant&, QString&)), Qt::DirectConnection);
 
 	connect(theGUI, SIGNAL(ReloadPanels()), this, SLOT(OnClear()));
@@ -68,11 +79,6 @@ CProcessTree::CProcessTree(QWidget *parent)
 
 	m_pMainLayout->addWidget(new CFinder(m_pSortProxy, this));
 
-#ifndef _DEBUG
-	connect(m_pProcessList->GetView()->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(OnUpdateHistory()));
-	connect(m_pProcessList->GetView(), SIGNAL(expanded(const QModelIndex &)), this, SLOT(OnUpdateHistory()));
-#endif
-
 
 	//m_pMenu = new QMenu();
 	m_pShowProperties = m_pMenu->addAction(tr("Properties"), this, SLOT(OnShowProperties()));
@@ -894,122 +900,54 @@ void CProcessTree::OnPermissions()
 }
 
 
-void CProcessTree::UpdateIndexWidget(int HistoryColumn, int CellHeight, QMap<quint64, CHistoryGraph*>& Graphs, QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> >& History)
+void CProcessTree::OnUpdateHistory()
 {
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > OldMap;
-	m_pProcessList->StartUpdatingWidgets(OldMap, History);
-	//for(QModelIndex Index = m_pProcessList->GetView()->indexAt(QPoint(0,0)); Index.isValid(); Index = m_pProcessList->GetView()->indexBelow(Index))
-	for(QModelIndex Index = m_pProcessList->GetView()->indexAt(QPoint(0,0)); Index.isValid(); Index = m_pProcessList->GetView()->indexBelow(Index))
-	{
-		Index = Index.sibling(Index.row(), HistoryColumn);
-		if(!m_pProcessList->GetView()->viewport()->rect().intersects(m_pProcessList->GetView()->visualRect(Index)))
-			break; // out of view
-		
-		QModelIndex ModelIndex = m_pSortProxy->mapToSource(Index);
-		quint64 PID = m_pProcessModel->Data(ModelIndex, Qt::UserRole, CProcessModel::eProcess).toULongLong();
+	float Div = (theConf->GetInt("Options/LinuxStyleCPU") == 1) ? theAPI->GetCpuCount() : 1.0f;
 
-		CHistoryWidget* pGraph = OldMap.take(PID).first;
-		if (!pGraph)
-		{
-			QModelIndex Index = m_pSortProxy->mapFromSource(ModelIndex);
+	// Note: the metrics are published column wise once per update, so we don't need to lock every process here
+	CProcessMetricsPtr pMetrics = theAPI->GetProcessMetrics();
+	const SProcessMetrics& Metrics = *pMetrics;
 
-			pGraph = new CHistoryWidget(Graphs[PID]);
-			pGraph->setFixedHeight(CellHeight);
-			History.insert(PID, qMakePair((QPointer<CHistoryWidget>)pGraph, QPersistentModelIndex(Index)));
-			m_pProcessList->GetView()->setIndexWidget(Index, pGraph);
-		}
-	}
-	m_pProcessList->EndUpdatingWidgets(OldMap, History);
-}
+	QTreeView* pView = m_pProcessList->GetView();
 
-void CProcessTree::OnUpdateHistory()
-{
-	float Div = (theConf->GetInt("Options/LinuxStyleCPU") == 1) ? theAPI->GetCpuCount() : 1.0f;
+	m_pHistoryDelegate->BeginUpdate();
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eCPU_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eCPU_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eCPU_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_CPU_Graphs;
-		foreach(const CProcessPtr& pProcess, m_Processes)
+		for (int i = 0; i < Metrics.size(); i++)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, Qt::green);
-				pGraph->AddValue(1, Qt::red);
-				m_CPU_Graphs.insert(PID, pGraph);
-			}
-
-			STaskStats CpuStats = pProcess->GetCpuStats();
-
-			pGraph->SetValue(0, CpuStats.CpuUsage / Div);
-			pGraph->SetValue(1, CpuStats.CpuKernelUsage / Div);
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { Metrics.CpuUsage[i] / Div, Metrics.CpuKernelUsage[i] / Div };
+			m_pHistoryDelegate->AddSample(CProcessModel::eCPU_History, Metrics.UIDs[i].ProcessId, Metrics.UIDs[i].CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_CPU_Graphs.take(TID)->deleteLater();
-
-		UpdateIndexWidget(CProcessModel::eCPU_History, CellHeight, m_CPU_Graphs, m_CPU_History);
 	}
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eGPU_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eGPU_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eGPU_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_GPU_Graphs;
 		foreach(const CProcessPtr& pProcess, m_Processes)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, Qt::green);
-				m_GPU_Graphs.insert(PID, pGraph);
-			}
-
+			SProcessUID UID = pProcess->GetUID();
 			SGpuStats GpuStats = pProcess->GetGpuStats();
 
-			pGraph->SetValue(0, GpuStats.GpuTimeUsage.Usage);
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { GpuStats.GpuTimeUsage.Usage };
+			m_pHistoryDelegate->AddSample(CProcessModel::eGPU_History, UID.ProcessId, UID.CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_GPU_Graphs.take(TID)->deleteLater();
-
-		UpdateIndexWidget(CProcessModel::eGPU_History, CellHeight, m_GPU_Graphs, m_GPU_History);
 	}
 
 	quint64 TotalMemoryUsed = theAPI->GetCommitedMemory();
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eMEM_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eMEM_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eMEM_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_MEM_Graphs;
-		foreach(const CProcessPtr& pProcess, m_Processes)
+		for (int i = 0; i < Metrics.size(); i++)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, QColor("#CCFF33"));
-				m_MEM_Graphs.insert(PID, pGraph);
-			}
-
-			pGraph->SetValue(0, TotalMemoryUsed ? (float)pProcess->GetWorkingSetSize() / TotalMemoryUsed : 0);
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { TotalMemoryUsed ? (float)Metrics.WorkingSetSize[i] / TotalMemoryUsed : 0 };
+			m_pHistoryDelegate->AddSample(CProcessModel::eMEM_History, Metrics.UIDs[i].ProcessId, Metrics.UIDs[i].CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_MEM_Graphs.take(TID)->deleteLater();
-
-		UpdateIndexWidget(CProcessModel::eMEM_History, CellHeight, m_MEM_Graphs, m_MEM_History);
 	}
 
 #ifdef WIN32
@@ -1026,33 +964,19 @@ void CProcessTree::OnUpdateHistory()
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eVMEM_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eVMEM_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eVMEM_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_VMEM_Graphs;
 		foreach(const CProcessPtr& pProcess, m_Processes)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, QColor("#CCFF33"));
-				m_VMEM_Graphs.insert(PID, pGraph);
-			}
-
+			SProcessUID UID = pProcess->GetUID();
 			SGpuStats GpuStats = pProcess->GetGpuStats();
 
 			float DedicatedMemory = TotalDedicated ? (float)GpuStats.GpuDedicatedUsage / TotalDedicated : 0;
 			float SharedMemory = TotalShared ? (float)GpuStats.GpuSharedUsage / TotalShared : 0;
 
-			pGraph->SetValue(0, qMax(DedicatedMemory, SharedMemory));
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { qMax(DedicatedMemory, SharedMemory) };
+			m_pHistoryDelegate->AddSample(CProcessModel::eVMEM_History, UID.ProcessId, UID.CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_VMEM_Graphs.take(TID)->deleteLater();
-
-		UpdateIndexWidget(CProcessModel::eVMEM_History, CellHeight, m_VMEM_Graphs, m_VMEM_History);
 	}
 
 
@@ -1064,65 +988,41 @@ void CProcessTree::OnUpdateHistory()
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eIO_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eIO_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eIO_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_IO_Graphs;
-		foreach(const CProcessPtr& pProcess, m_Processes)
+		for (int i = 0; i < Metrics.size(); i++)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, Qt::green);
-				pGraph->AddValue(1, Qt::red);
-				pGraph->AddValue(2, Qt::blue);
-				m_IO_Graphs.insert(PID, pGraph);
-			}
-
-			SProcStats IoStats = pProcess->GetStats();
-
-			pGraph->SetValue(0, TotalDisk ? (float)qMax(IoStats.Disk.ReadRate.Get(), IoStats.Io.ReadRate.Get()) / TotalDisk : 0);
-			pGraph->SetValue(1, TotalDisk ? (float)qMax(IoStats.Disk.WriteRate.Get(), IoStats.Io.WriteRate.Get()) / TotalDisk : 0);
-			pGraph->SetValue(2, TotalIO ? (float)IoStats.Io.OtherRate.Get() / TotalIO : 0);
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { 
+				TotalDisk ? (float)qMax(Metrics.DiskReadRate[i], Metrics.IoReadRate[i]) / TotalDisk : 0,
+				TotalDisk ? (float)qMax(Metrics.DiskWriteRate[i], Metrics.IoWriteRate[i]) / TotalDisk : 0,
+				TotalIO ? (float)Metrics.IoOtherRate[i] / TotalIO : 0
+			};
+			m_pHistoryDelegate->AddSample(CProcessModel::eIO_History, Metrics.UIDs[i].ProcessId, Metrics.UIDs[i].CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_IO_Graphs.take(TID)->deleteLater();
-
-		UpdateIndexWidget(CProcessModel::eIO_History, CellHeight, m_IO_Graphs, m_IO_History);
 	}
 
 	quint64 TotalNet = SysStats.Net.ReceiveRate.Get() + SysStats.Net.SendRate.Get();
 
 	if (m_pProcessModel->IsColumnEnabled(CProcessModel::eNET_History))
 	{
-		int CellHeight = theGUI->GetCellHeight();
-		int CellWidth = m_pProcessList->GetView()->columnWidth(CProcessModel::eNET_History);
+		int CellWidth = pView->columnWidth(CProcessModel::eNET_History);
 
-		QMap<quint64, CHistoryGraph*> Old = m_NET_Graphs;
-		foreach(const CProcessPtr& pProcess, m_Processes)
+		for (int i = 0; i < Metrics.size(); i++)
 		{
-			quint64 PID = pProcess->GetProcessId();
-			CHistoryGraph* pGraph = Old.take(PID);
-			if (!pGraph)
-			{
-				pGraph = new CHistoryGraph(true, Qt::white, this);
-				pGraph->AddValue(0, Qt::green);
-				pGraph->AddValue(1, Qt::red);
-				m_NET_Graphs.insert(PID, pGraph);
-			}
-
-			SProcStats IoStats = pProcess->GetStats();
-
-			pGraph->SetValue(0, TotalNet ? (float)IoStats.Net.ReceiveRate.Get() / TotalNet : 0);
-			pGraph->SetValue(1, TotalNet ? (float)IoStats.Net.SendRate.Get() / TotalNet : 0);
-			pGraph->Update(CellHeight, CellWidth);
+			float Values[] = { 
+				TotalNet ? (float)Metrics.NetReceiveRate[i] / TotalNet : 0,
+				TotalNet ? (float)Metrics.NetSendRate[i] / TotalNet : 0
+			};
+			m_pHistoryDelegate->AddSample(CProcessModel::eNET_History, Metrics.UIDs[i].ProcessId, Metrics.UIDs[i].CreateTime, Values, CellWidth);
 		}
-		foreach(quint64 TID, Old.keys())
-			m_NET_Graphs.take(TID)->deleteLater();
+	}
+
+	m_pHistoryDelegate->EndUpdate();
 
-		UpdateIndexWidget(CProcessModel::eNET_History, CellHeight, m_NET_Graphs, m_NET_History);
+	// repaint the visible graph cells, they moved on by one sample
+	for (int i = CProcessModel::eCPU_History; i <= CProcessModel::eVMEM_History; i++)
+	{
+		if (m_pProcessModel->IsColumnEnabled(i))
+			pView->viewport()->update(pView->header()->sectionViewportPosition(i), 0, pView->columnWidth(i), pView->viewport()->height());
 	}
 }
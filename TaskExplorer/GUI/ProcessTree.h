@@ -1,7 +1,7 @@
 #pragma once
 #include <qwidget.h>
 #include "../../MiscHelpers/Common/SplitTreeView.h"
-#include "../../MiscHelpers/Common/HistoryGraph.h"
+#include "../../MiscHelpers/Common/HistoryDelegate.h"
 #include "../API/ProcessInfo.h"
 #include "TaskView.h"
 
@@ -80,8 +80,6 @@ protected:
 	}
 	virtual QList<CTaskPtr>		GetSellectedTasks();
 
-	void						UpdateIndexWidget(int HistoryColumn, int CellHeight, QMap<quint64, CHistoryGraph*>& Graphs, QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> >& History);
-
 	virtual void				OnMenu(const QPoint& Point);
 	virtual QTreeView*			GetView() 				{ return m_pProcessList->GetView(); }
 	virtual QAbstractItemModel* GetModel()				{ return m_pSortProxy; }
@@ -103,18 +101,7 @@ private:
 	QSortFilterProxyModel*	m_pSortProxy;
 	CSplitTreeView*			m_pProcessList;
 
-	QMap<quint64, CHistoryGraph*> m_CPU_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_CPU_History;
-	QMap<quint64, CHistoryGraph*> m_MEM_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_MEM_History;
-	QMap<quint64, CHistoryGraph*> m_IO_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_IO_History;
-	QMap<quint64, CHistoryGraph*> m_NET_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_NET_History;
-	QMap<quint64, CHistoryGraph*> m_GPU_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_GPU_History;
-	QMap<quint64, CHistoryGraph*> m_VMEM_Graphs;
-	QMap<quint64, QPair<QPointer<CHistoryWidget>, QPersistentModelIndex> > m_VMEM_History;
+	CHistoryDelegate*		m_pHistoryDelegate;
 
 	QMenu*					m_pHeaderMenu;
 	QMap<QCheckBox*,int>	m_Columns;
@@ -65,14 +65,17 @@ CAbstractFinder* CHandleSearch::NewFinder()
 	int Type = m_pType->currentData().toInt(&bOk);
 	if (!bOk)
 		Type = -1;
-	return CAbstractFinder::FindHandles(Type, RegExp);
+
+	CAbstractFinder* pFinder = CAbstractFinder::FindHandles(Type, RegExp);
+	if (pFinder)
+		QObject::connect(pFinder, SIGNAL(HandleResults(QList<CHandlePtr>)), this, SLOT(OnHandleResults(QList<CHandlePtr>)));
+	return pFinder;
 }
 
-void CHandleSearch::OnResults(QList<QSharedPointer<QObject>> List)
+void CHandleSearch::OnHandleResults(QList<CHandlePtr> List)
 {
-	foreach(const QSharedPointer<QObject>& pObject, List)
+	foreach(const CHandlePtr& pHandle, List)
 	{
-		CHandlePtr pHandle = pObject.staticCast<CHandleInfo>();
 		m_Handles.insert(pHandle->GetHandleId(), pHandle);
 	}
 
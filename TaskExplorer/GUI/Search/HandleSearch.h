@@ -11,7 +11,7 @@ public:
 	virtual ~CHandleSearch();
 
 private slots:
-	virtual void			OnResults(QList<QSharedPointer<QObject>> List);
+	virtual void			OnHandleResults(QList<CHandlePtr> List);
 
 protected:
 	virtual CAbstractFinder* NewFinder();
@@ -13,7 +13,7 @@ private slots:
 	virtual void		OnFind();
 
 	virtual void		OnProgress(float value, const QString& Info);
-	virtual void		OnResults(QList<QSharedPointer<QObject>> List) = 0;
+	virtual void		OnResults(QList<QSharedPointer<QObject>> List) {}
 	virtual void		OnError(const QString& Error, int Code);
 	virtual void		OnFinished();
 
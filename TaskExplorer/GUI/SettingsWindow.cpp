@@ -35,6 +35,11 @@ CSettingsWindow::CSettingsWindow(QWidget *parent)
 
 	ui.chkShow32->setChecked(theConf->GetBool("Options/Show32", true));
 
+	ui.chkLinuxIoUring->setChecked(theConf->GetBool("Options/LinuxUseIoUring", false));
+#ifdef WIN32
+	ui.chkLinuxIoUring->setVisible(false);
+#endif
+
 	ui.chkDarkTheme->setChecked(theConf->GetBool("MainWindow/DarkTheme", false));
 
 	ui.highlightCount->setValue(theConf->GetInt("Options/HighLoadHighlightCount", 5));
@@ -158,6 +163,8 @@ void CSettingsWindow::apply()
 
 	theConf->SetValue("Options/Show32", ui.chkShow32->isChecked());
 
+	theConf->SetValue("Options/LinuxUseIoUring", ui.chkLinuxIoUring->isChecked());
+
 	theConf->SetValue("MainWindow/DarkTheme", ui.chkDarkTheme->isChecked());
 
 	theConf->SetValue("Options/HighLoadHighlightCount", ui.highlightCount->value());
@@ -258,6 +258,9 @@ void CStatsView::ShowProcesses(const QList<CProcessPtr>& Processes)
 	if (Processes.isEmpty())
 		return;
 
+	// Note: the process stats show the io counters and context switches, so they must be collected as long as we are visible
+	theAPI->SetProcessDemand(this, eDemandAll);
+
 	enum EFormat
 	{
 		eUndefined = 0,
@@ -295,89 +298,90 @@ void CStatsView::ShowProcesses(const QList<CProcessPtr>& Processes)
 
 	foreach(const CProcessPtr& pProcess, Processes)
 	{
-		STaskStatsEx CpuStats = pProcess->GetCpuStats();
+		SProcessSample Sample = pProcess->GetSnapshot();
+		const STaskSampleEx& CpuStats = Sample.Cpu;
 
 		// CPU
-		AccStats[m_pCycles].AddSumm(eCount, eFormatNumber, CpuStats.CycleDelta.Value);
-		AccStats[m_pCycles].AddSumm(eDelta, eFormatNumber, CpuStats.CycleDelta.Delta);
+		AccStats[m_pCycles].AddSumm(eCount, eFormatNumber, CpuStats.Cycles);
+		AccStats[m_pCycles].AddSumm(eDelta, eFormatNumber, CpuStats.CyclesDelta);
 
-		AccStats[m_pKernelTime].AddSumm(eCount, eFormatTime, CpuStats.CpuKernelDelta.Value / CPU_TIME_DIVIDER);
-		AccStats[m_pKernelTime].AddSumm(eDelta, eFormatTime, CpuStats.CpuKernelDelta.Delta / CPU_TIME_DIVIDER);
+		AccStats[m_pKernelTime].AddSumm(eCount, eFormatTime, CpuStats.CpuKernelTime / CPU_TIME_DIVIDER);
+		AccStats[m_pKernelTime].AddSumm(eDelta, eFormatTime, CpuStats.CpuKernelTimeDelta / CPU_TIME_DIVIDER);
 
-		AccStats[m_pUserTime].AddSumm(eCount, eFormatTime, CpuStats.CpuUserDelta.Value / CPU_TIME_DIVIDER);
-		AccStats[m_pUserTime].AddSumm(eDelta, eFormatTime, CpuStats.CpuUserDelta.Delta / CPU_TIME_DIVIDER);
+		AccStats[m_pUserTime].AddSumm(eCount, eFormatTime, CpuStats.CpuUserTime / CPU_TIME_DIVIDER);
+		AccStats[m_pUserTime].AddSumm(eDelta, eFormatTime, CpuStats.CpuUserTimeDelta / CPU_TIME_DIVIDER);
 
-		AccStats[m_pTotalTime].AddSumm(eCount, eFormatTime, (CpuStats.CpuKernelDelta.Value + CpuStats.CpuUserDelta.Value) / CPU_TIME_DIVIDER);
-		AccStats[m_pTotalTime].AddSumm(eDelta, eFormatTime, (CpuStats.CpuKernelDelta.Delta + CpuStats.CpuUserDelta.Delta) / CPU_TIME_DIVIDER);
+		AccStats[m_pTotalTime].AddSumm(eCount, eFormatTime, (CpuStats.CpuKernelTime + CpuStats.CpuUserTime) / CPU_TIME_DIVIDER);
+		AccStats[m_pTotalTime].AddSumm(eDelta, eFormatTime, (CpuStats.CpuKernelTimeDelta + CpuStats.CpuUserTimeDelta) / CPU_TIME_DIVIDER);
 
-		AccStats[m_pContextSwitches].AddSumm(eCount, eFormatNumber, CpuStats.ContextSwitchesDelta.Value);
-		AccStats[m_pContextSwitches].AddSumm(eDelta, eFormatNumber, CpuStats.ContextSwitchesDelta.Delta);
+		AccStats[m_pContextSwitches].AddSumm(eCount, eFormatNumber, CpuStats.ContextSwitches);
+		AccStats[m_pContextSwitches].AddSumm(eDelta, eFormatNumber, CpuStats.ContextSwitchesDelta);
 
 		// Memory
-		AccStats[m_pPrivateBytes].AddSumm(eSize, eFormatSize, CpuStats.PrivateBytesDelta.Value);
-		AccStats[m_pPrivateBytes].AddSumm(eDelta, eFormatSize, CpuStats.PrivateBytesDelta.Delta);
+		AccStats[m_pPrivateBytes].AddSumm(eSize, eFormatSize, CpuStats.PrivateBytes);
+		AccStats[m_pPrivateBytes].AddSumm(eDelta, eFormatSize, CpuStats.PrivateBytesDelta);
 
-		AccStats[m_pVirtualSize].AddSumm(eSize, eFormatSize, pProcess->GetVirtualSize());
-		AccStats[m_pVirtualSize].AddSumm(ePeak, eFormatSize, pProcess->GetPeakVirtualSize());
+		AccStats[m_pVirtualSize].AddSumm(eSize, eFormatSize, Sample.VirtualSize);
+		AccStats[m_pVirtualSize].AddSumm(ePeak, eFormatSize, Sample.PeakVirtualSize);
 
-		AccStats[m_pPageFaults].AddSumm(eCount, eFormatNumber, CpuStats.PageFaultsDelta.Value);
-		AccStats[m_pPageFaults].AddSumm(eDelta, eFormatNumber, CpuStats.PageFaultsDelta.Delta);
+		AccStats[m_pPageFaults].AddSumm(eCount, eFormatNumber, CpuStats.PageFaults);
+		AccStats[m_pPageFaults].AddSumm(eDelta, eFormatNumber, CpuStats.PageFaultsDelta);
 
-		AccStats[m_pHardFaults].AddSumm(eCount, eFormatNumber, CpuStats.HardFaultsDelta.Value);
-		AccStats[m_pHardFaults].AddSumm(eDelta, eFormatNumber, CpuStats.HardFaultsDelta.Delta);
+		AccStats[m_pHardFaults].AddSumm(eCount, eFormatNumber, CpuStats.HardFaults);
+		AccStats[m_pHardFaults].AddSumm(eDelta, eFormatNumber, CpuStats.HardFaultsDelta);
 
-		AccStats[m_pWorkingSet].AddSumm(eSize, eFormatSize, pProcess->GetWorkingSetSize());
+		AccStats[m_pWorkingSet].AddSumm(eSize, eFormatSize, Sample.WorkingSetSize);
 
-		AccStats[m_pPrivateWS].AddSumm(eSize, eFormatSize, pProcess->GetPrivateWorkingSetSize());
+		AccStats[m_pPrivateWS].AddSumm(eSize, eFormatSize, Sample.PrivateWorkingSetSize);
 
 		AccStats[m_pShareableWS].AddSumm(eSize, eFormatSize, pProcess->GetShareableWorkingSetSize());
 		AccStats[m_pSharedWS].AddSumm(eSize, eFormatSize, pProcess->GetSharedWorkingSetSize());
 
 		// IO
-		SProcStats Stats = pProcess->GetStats();
+		const SProcSample& Stats = Sample.Stats;
 
-		AccStats[m_pIOReads].AddSumm(eCount, eFormatNumber, Stats.Io.ReadDelta.Value);
-		AccStats[m_pIOReads].AddSumm(eSize, eFormatSize, Stats.Io.ReadRawDelta.Value);
-		AccStats[m_pIOReads].AddSumm(eRate, eFormatRate, Stats.Io.ReadRate.Get());
-		AccStats[m_pIOReads].AddSumm(eDelta, eFormatNumber, Stats.Io.ReadDelta.Delta);
+		AccStats[m_pIOReads].AddSumm(eCount, eFormatNumber, Stats.Io.ReadCount);
+		AccStats[m_pIOReads].AddSumm(eSize, eFormatSize, Stats.Io.ReadRaw);
+		AccStats[m_pIOReads].AddSumm(eRate, eFormatRate, Stats.Io.ReadRate);
+		AccStats[m_pIOReads].AddSumm(eDelta, eFormatNumber, Stats.Io.ReadDelta);
 
-		AccStats[m_pIOWrites].AddSumm(eCount, eFormatNumber, Stats.Io.WriteDelta.Value);
-		AccStats[m_pIOWrites].AddSumm(eSize, eFormatSize, Stats.Io.WriteRawDelta.Value);
-		AccStats[m_pIOWrites].AddSumm(eRate, eFormatRate, Stats.Io.WriteRate.Get());
-		AccStats[m_pIOWrites].AddSumm(eDelta, eFormatNumber, Stats.Io.WriteDelta.Delta);
+		AccStats[m_pIOWrites].AddSumm(eCount, eFormatNumber, Stats.Io.WriteCount);
+		AccStats[m_pIOWrites].AddSumm(eSize, eFormatSize, Stats.Io.WriteRaw);
+		AccStats[m_pIOWrites].AddSumm(eRate, eFormatRate, Stats.Io.WriteRate);
+		AccStats[m_pIOWrites].AddSumm(eDelta, eFormatNumber, Stats.Io.WriteDelta);
 
-		AccStats[m_pIOOther].AddSumm(eCount, eFormatNumber, Stats.Io.OtherDelta.Value);
-		AccStats[m_pIOOther].AddSumm(eSize, eFormatSize, Stats.Io.OtherRawDelta.Value);
-		AccStats[m_pIOOther].AddSumm(eRate, eFormatRate, Stats.Io.OtherRate.Get());
-		AccStats[m_pIOOther].AddSumm(eDelta, eFormatNumber, Stats.Io.OtherDelta.Delta);
+		AccStats[m_pIOOther].AddSumm(eCount, eFormatNumber, Stats.Io.OtherCount);
+		AccStats[m_pIOOther].AddSumm(eSize, eFormatSize, Stats.Io.OtherRaw);
+		AccStats[m_pIOOther].AddSumm(eRate, eFormatRate, Stats.Io.OtherRate);
+		AccStats[m_pIOOther].AddSumm(eDelta, eFormatNumber, Stats.Io.OtherDelta);
 
-		AccStats[m_pDiskReads].AddSumm(eCount, eFormatNumber, Stats.Disk.ReadDelta.Value);
-		AccStats[m_pDiskReads].AddSumm(eSize, eFormatSize, Stats.Disk.ReadRawDelta.Value);
-		AccStats[m_pDiskReads].AddSumm(eRate, eFormatRate, Stats.Disk.ReadRate.Get());
-		AccStats[m_pDiskReads].AddSumm(eDelta, eFormatNumber, Stats.Disk.ReadDelta.Delta);
+		AccStats[m_pDiskReads].AddSumm(eCount, eFormatNumber, Stats.Disk.ReadCount);
+		AccStats[m_pDiskReads].AddSumm(eSize, eFormatSize, Stats.Disk.ReadRaw);
+		AccStats[m_pDiskReads].AddSumm(eRate, eFormatRate, Stats.Disk.ReadRate);
+		AccStats[m_pDiskReads].AddSumm(eDelta, eFormatNumber, Stats.Disk.ReadDelta);
 
-		AccStats[m_pDiskWrites].AddSumm(eCount, eFormatNumber, Stats.Disk.WriteDelta.Value);
-		AccStats[m_pDiskWrites].AddSumm(eSize, eFormatSize, Stats.Disk.WriteRawDelta.Value);
-		AccStats[m_pDiskWrites].AddSumm(eRate, eFormatRate, Stats.Disk.WriteRate.Get());
-		AccStats[m_pDiskWrites].AddSumm(eDelta, eFormatNumber, Stats.Disk.WriteDelta.Delta);
+		AccStats[m_pDiskWrites].AddSumm(eCount, eFormatNumber, Stats.Disk.WriteCount);
+		AccStats[m_pDiskWrites].AddSumm(eSize, eFormatSize, Stats.Disk.WriteRaw);
+		AccStats[m_pDiskWrites].AddSumm(eRate, eFormatRate, Stats.Disk.WriteRate);
+		AccStats[m_pDiskWrites].AddSumm(eDelta, eFormatNumber, Stats.Disk.WriteDelta);
 
 		if (m_MonitorsETW)
 		{
-			AccStats[m_pNetSends].AddSumm(eCount, eFormatNumber, Stats.Net.SendDelta.Value);
-			AccStats[m_pNetSends].AddSumm(eSize, eFormatSize, Stats.Net.SendRawDelta.Value);
-			AccStats[m_pNetSends].AddSumm(eRate, eFormatRate, Stats.Net.SendRate.Get());
-			AccStats[m_pNetSends].AddSumm(eDelta, eFormatNumber, Stats.Net.SendDelta.Delta);
-
-			AccStats[m_pNetReceives].AddSumm(eCount, eFormatNumber, Stats.Net.ReceiveDelta.Value);
-			AccStats[m_pNetReceives].AddSumm(eSize, eFormatSize, Stats.Net.ReceiveRawDelta.Value);
-			AccStats[m_pNetReceives].AddSumm(eRate, eFormatRate, Stats.Net.ReceiveRate.Get());
-			AccStats[m_pNetReceives].AddSumm(eDelta, eFormatNumber, Stats.Net.ReceiveDelta.Delta);
+			AccStats[m_pNetSends].AddSumm(eCount, eFormatNumber, Stats.Net.SendCount);
+			AccStats[m_pNetSends].AddSumm(eSize, eFormatSize, Stats.Net.SendRaw);
+			AccStats[m_pNetSends].AddSumm(eRate, eFormatRate, Stats.Net.SendRate);
+			AccStats[m_pNetSends].AddSumm(eDelta, eFormatNumber, Stats.Net.SendDelta);
+
+			AccStats[m_pNetReceives].AddSumm(eCount, eFormatNumber, Stats.Net.ReceiveCount);
+			AccStats[m_pNetReceives].AddSumm(eSize, eFormatSize, Stats.Net.ReceiveRaw);
+			AccStats[m_pNetReceives].AddSumm(eRate, eFormatRate, Stats.Net.ReceiveRate);
+			AccStats[m_pNetReceives].AddSumm(eDelta, eFormatNumber, Stats.Net.ReceiveDelta);
 		}
 
 		// other
-		AccStats[m_pThreads].AddSumm(eCount, eFormatNumber, pProcess->GetNumberOfThreads());
-		AccStats[m_pThreads].AddSumm(ePeak, eFormatNumber, pProcess->GetPeakNumberOfThreads());
-		AccStats[m_pHandles].AddSumm(eCount, eFormatNumber, pProcess->GetNumberOfHandles());
+		AccStats[m_pThreads].AddSumm(eCount, eFormatNumber, Sample.NumberOfThreads);
+		AccStats[m_pThreads].AddSumm(ePeak, eFormatNumber, Sample.PeakNumberOfThreads);
+		AccStats[m_pHandles].AddSumm(eCount, eFormatNumber, Sample.NumberOfHandles);
 		AccStats[m_pHandles].AddSumm(ePeak, eFormatNumber, pProcess->GetPeakNumberOfHandles());
 
 #ifdef WIN32
@@ -427,6 +431,13 @@ void CStatsView::ShowProcesses(const QList<CProcessPtr>& Processes)
 	}
 }
 
+void CStatsView::hideEvent(QHideEvent* pEvent)
+{
+	theAPI->SetProcessDemand(this, 0);
+
+	CPanelView::hideEvent(pEvent);
+}
+
 void CStatsView::ShowIoStats(const SSysStats& Stats)
 {
 	m_pIOReads->setText(eCount, FormatNumber(Stats.Io.ReadDelta.Value));
@@ -43,6 +43,8 @@ protected:
 
 	void					ShowIoStats(const SSysStats& Stats);
 
+	virtual void			hideEvent(QHideEvent* pEvent);
+
 private:
 	EView					m_eView;
 
@@ -502,7 +502,7 @@ void CHandlesView::OnItemSelected(const QModelIndex &current)
 	pDetails->clear();
 
 #ifdef WIN32
-	CWinHandle* pWinHandle = qobject_cast<CWinHandle*>(pHandle.data());
+	CWinHandle* pWinHandle = static_cast<CWinHandle*>(pHandle.data());
 
 	QString TypeName = pWinHandle->GetTypeName();
 	CWinHandle::SHandleInfo HandleInfo = pWinHandle->GetHandleInfo();
@@ -754,7 +754,7 @@ void CHandlesView::OnDoubleClicked()
 
 	QString Type;
 #ifdef WIN32
-	CWinHandle* pWinHandle = qobject_cast<CWinHandle*>(pHandle.data());
+	CWinHandle* pWinHandle = static_cast<CWinHandle*>(pHandle.data());
 	Type = pWinHandle->GetTypeName();
 #else
 	// unix
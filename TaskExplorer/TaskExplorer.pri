@@ -56,6 +56,7 @@ HEADERS += ./stdafx.h \
     ./GUI/Search/StringView.h \
     ./GUI/Search/SearchWindow.h \
     ./API/MiscStats.h \
+    ./API/SeqLock.h \
     ./API/StackTrace.h \
     ./API/SystemAPI.h \
     ./API/ProcessInfo.h \
@@ -64,6 +65,7 @@ HEADERS += ./stdafx.h \
     ./API/ThreadInfo.h \
     ./API/ServiceInfo.h \
     ./API/ModuleInfo.h \
+    ./API/IconCache.h \
     ./API/AbstractTask.h \
     ./API/DriverInfo.h \
     ./API/DnsEntry.h \
@@ -77,11 +79,19 @@ HEADERS += ./stdafx.h \
     ./API/Monitors/GpuMonitor.h \
     ./API/Monitors/NetMonitor.h \
     ./API/Linux/LinuxAPI.h \
+    ./API/Linux/LinuxProcess.h \
+    ./API/Linux/ProcConnector.h \
+    ./API/Linux/SockDiag.h \
+    ./API/Linux/LinuxSocket.h \
+    ./API/Linux/ProcFileCache.h \
+    ./API/Linux/ProcUring.h \
+    ./API/Linux/ProcParsers.h \
     ./Common/Common.h \
     ./Common/DebugHelpers.h \
     ./Common/ExitDialog.h \
     ./Common/FlexError.h \
     ./Common/FlowLayout.h \
+    ./Common/HistoryDelegate.h \
     ./Common/HistoryGraph.h \
     ./Common/qzlib.h \
     ./Common/TreeWidgetEx.h \
@@ -91,6 +101,7 @@ HEADERS += ./stdafx.h \
     ./Common/SplitTreeView.h \
     ./Common/TreeItemModel.h \
     ./Common/ListItemModel.h \
+    ./Common/NodePool.h \
     ./Common/IncrementalPlot.h \
     ./Common/KeyValueInputDialog.h \
     ./Common/Finder.h \
@@ -164,6 +175,7 @@ SOURCES += ./main.cpp \
     ./API/MemDumper.cpp \
     ./API/MemoryInfo.cpp \
     ./API/ModuleInfo.cpp \
+    ./API/IconCache.cpp \
     ./API/AbstractInfo.cpp \
     ./API/ProcessInfo.cpp \
     ./API/ServiceInfo.cpp \
@@ -177,22 +189,32 @@ SOURCES += ./main.cpp \
     ./API/Monitors/GpuMonitor.cpp \
     ./API/Monitors/NetMonitor.cpp \
     ./API/Linux/LinuxAPI.cpp \
+    ./API/Linux/LinuxProcess.cpp \
+    ./API/Linux/ProcConnector.cpp \
+    ./API/Linux/SockDiag.cpp \
+    ./API/Linux/LinuxSocket.cpp \
+    ./API/Linux/ProcFileCache.cpp \
+    ./API/Linux/ProcUring.cpp \
+    ./API/Linux/ProcParsers.cpp \
     ./Common/CheckableMessageBox.cpp \
     ./Common/ComboInputDialog.cpp \
     ./Common/Common.cpp \
     ./Common/DebugHelpers.cpp \
     ./Common/Finder.cpp \
     ./Common/FlowLayout.cpp \
+    ./Common/HistoryDelegate.cpp \
     ./Common/IncrementalPlot.cpp \
     ./Common/ItemChooser.cpp \
     ./Common/KeyValueInputDialog.cpp \
     ./Common/ListItemModel.cpp \
+    ./Common/NodePool.cpp \
     ./Common/MultiLineInputDialog.cpp \
     ./Common/SmartGridWidget.cpp \
     ./Common/PanelView.cpp \
     ./Common/qzlib.cpp \
     ./Common/Settings.cpp \
     ./Common/SettingsWidgets.cpp \
+    ./Common/SortFilterProxyModel.cpp \
     ./Common/SplitTreeView.cpp \
     ./Common/TabPanel.cpp \
     ./Common/TreeItemModel.cpp \